@@ -12,7 +12,7 @@
  * - Provide several animation patterns triggered on time events
  * 
  * - Requires RTC Module
- * - Provides simple DST change for Western Europe
+ * - Provides DST change per time zone (Western Europe by default; see tz.h)
  * 
  * - Supports MP3 player Module
  * - Provides speech per minute (Best to just enable this per hour or so)
@@ -22,7 +22,10 @@
  * 
  */
 
+#include "./scheduler.h"
 #include "./rtc.h"
+#include "./color.h"
+#include "./arbiter.h"
 #include "./led.h"
 #include "./clock.h"
 #include "./speech.h"
@@ -40,58 +43,79 @@ void setup() {
   Mp3Speech.init();
 
     
+  // Time events; the ones due at the same minute run in this order
+  Schedule.every(60, CheckDST);
+  Schedule.every(60, PrepareHour, 0, 59);  // A minute before the hour is said
+  Schedule.every(15, SyncTime);
+  Schedule.every(60, HourChanged,        SCHEDULE_EXCLUSIVE);
+  Schedule.every(15, QuarterChanged,     SCHEDULE_EXCLUSIVE);
+  Schedule.every( 5, FiveMinutesChanged, SCHEDULE_EXCLUSIVE);
+  //Schedule.every(1, MinuteChanged);
+  Schedule.onDST(DSTChanged);
+
   // Initializing ALL the colors would be nice here...
   RGBShow();
-  Intro();  
+  Intro();                  // Queued; starts when RGBShow() is done
   
 }
 
 void loop() {
 
   // Send something through serial input to set the time to the RTC time programmed
+  // (not when the MP3 player is on the hardware UART; its answers come in there)
+#if MP3TRANSPORT != MP3_HARDWARESERIAL
   if (Serial.available()) {
     SerialDataProvided();
   }
+#endif
   
   //Vu();
   //Smiley();
   //RandomLedColors();
 
+  // Time events are run by the Schedule
+  Current.getTime();
+  Schedule.update(Current.tick.epoch);
+
   Mp3Speech.update();
-  LedClock.update();
-  
-  if ( Current.ExecuteHourChangePattern ) {
-      //Serial.println(F("Hour has changed!"));
-      RandomLedColors(HOURPATTERNTIMEOUT); 
-      Current.ExecuteHourChangePattern        = false;
-      Current.ExecuteQuarterChangePattern     = false;
-      Current.ExecuteFiveMinuteChangePattern  = false;
-      Current.ExecuteMinuteChangePattern      = false;
-      Mp3Speech.Time(Current.Hour(), Current.Minute());
-  }
-  
-  if ( Current.ExecuteQuarterChangePattern ) {
-      Serial.println(F("Quarter has changed!"));
-      QuarterChange(QUARTERPATTERNTIMEOUT);
-      Current.ExecuteQuarterChangePattern     = false;
-      Current.ExecuteFiveMinuteChangePattern  = false;
-      Current.ExecuteMinuteChangePattern      = false;
 
+  // Animations are stepped one frame at a time; the clock is shown when none is running
+  if ( not LedPatterns.update() ) {
+    LedClock.update();
   }
 
-  if ( Current.ExecuteFiveMinuteChangePattern ) {
-      Serial.println(F("Five Minutes have changed!"));
-      Current.ExecuteFiveMinuteChangePattern  = false;
-      Current.ExecuteMinuteChangePattern      = false;
-  }
+  // Nothing to poll for with the SQW tick; wait for the next interrupt
+  Current.idle();
+
+}
 
-  if ( Current.ExecuteMinuteChangePattern ) {
-      // Say the time every minute
-      //Serial.println(F("Minutes have changed!"));
-//      Mp3Speech.Time(Current.Hour(), Current.Minute());
-      Current.ExecuteMinuteChangePattern      = false;
-  } 
+void HourChanged() {
+  //Serial.println(F("Hour has changed!"));
+  RandomLedColors(HOURPATTERNTIMEOUT); 
+  Mp3Speech.Time(Current.tick.hour12, Current.tick.minute);
+}
+
+void PrepareHour() {
+  Mp3Speech.prepare();
+}
+
+void QuarterChanged() {
+  Serial.println(F("Quarter has changed!"));
+  QuarterChange(QUARTERPATTERNTIMEOUT);
+}
+
+void FiveMinutesChanged() {
+  Serial.println(F("Five Minutes have changed!"));
+}
+
+void MinuteChanged() {
+  // Say the time every minute
+  //Serial.println(F("Minutes have changed!"));
+  Mp3Speech.Time(Current.tick.hour12, Current.tick.minute);
+}
 
+void DSTChanged() {
+  Serial.println(F("DST has changed!"));
 }
 
 void SerialDataProvided() {
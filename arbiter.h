@@ -0,0 +1,57 @@
+/*
+ * Arbiter Library
+ *
+ * Pushing a frame to the WS2812's keeps the interrupts off for ~30 us per LED. SoftwareSerial needs its pin change
+ * interrupt at the start bit of every byte; a byte arriving during a push comes in garbled and takes the rest of its
+ * answer with it. The hardware UART holds a byte on its own, so the USB serial port loses nothing to a push.
+ *
+ * Whoever knows serial bytes are about to come in says so with expect(); the MP3 answer after a command, the rest
+ * of an answer that started and the finished answer around the predicted end of a sample (see speech.h).
+ * show() in led.h asks allow() before it pushes and keeps the frame until the window is over, but never longer than
+ * ARBITERMAXHOLD so the leds don't lag behind visibly.
+ *
+ *  Functions:
+ *    expect()          -- Serial bytes are expected within the next milliseconds; hold the led pushes
+ *    allow()           -- Whether a led push may turn the interrupts off now
+ *
+ */
+
+#define ARBITERMAXHOLD           60  // Milliseconds a led frame may be held back at most
+
+class Arbiter {
+private:
+  unsigned long quietUntil    = 0;    // millis() up to which serial bytes are expected
+  unsigned long holdSince     = 0;    // millis() when the frame waiting was first held back
+  bool          holding       = false;
+
+public:
+  unsigned long framesDeferred = 0;   // Frames held back until the serial bytes were in
+  unsigned long framesForced   = 0;   // Frames pushed during a window after ARBITERMAXHOLD
+
+void expect(uint16_t milliseconds) {
+  if ( (long)( millis() + milliseconds - quietUntil ) > 0 ) {
+    quietUntil = millis() + milliseconds;
+  }
+}
+
+bool allow() {
+  if ( (long)( millis() - quietUntil ) >= 0 ) {
+    holding = false;
+    return true;
+  }
+
+  if ( not holding ) {
+    holding   = true;
+    holdSince = millis();
+    framesDeferred++;
+  } else if ( millis() - holdSince >= ARBITERMAXHOLD ) {
+    holding   = false;
+    framesForced++;
+    return true;
+  }
+  return false;
+}
+
+};
+
+Arbiter LedArbiter;
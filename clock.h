@@ -6,6 +6,9 @@
  *   - Handling Hours, Minutes and Seconds to act together as they represent the clock
  *   - Handling the timings and the triggering of the speech which is driven by the speech.h library
  * 
+ *  The hands are composed with the saturating color math from color.h; a hand on top of another hand or
+ *  the quarter background never wraps around to a dim color.
+ * 
  *  Functions:
  *    updateLedBackground()     -- Setting the Quarters in a led color to get a better visiualisation of the clock
  *    determineLedPositions()   -- Determining the Hour / Minute / Second led position and checking if they overlap
@@ -13,34 +16,50 @@
  *    updateHourLed()           -- Setting the Hour led
  *    updateMinuteLed()         -- Setting the Minute led
  *    updateSecondLed()         -- Setting the Second led
+ *    secondsFade()             -- The brightness of the Second led for the time elapsed since the last time change
  *    
  *    displayCurrentTime()      -- Orchestrating the calling of all determinations and setting the lighting of the leds
- *                                 Also handling the connection to the RTC and indicating if this connection is broken
+ *                                 The quarters turn red while the RTC is away (the time runs on; see rtc.h)
  *                                 
- *    update()                  -- The method that handles getting the latest time state and actually showing the leds                             
+ *    update()                  -- The method that handles actually showing the leds for the latest time state (getTime() in the loop)
+ *                                 (The leds are only pushed when the frame changed; see led.h)
  *    
  */
 
-#define SECONDSRISE               1  // This is the rise step of your led (Modify depending on the update speed of your Arduino; smaller for slower rise)
 #define SECONDSBLINKEACH       1000  // Note this is the speed in milliseconds
+#define SECONDSRISETIME          40  // Milliseconds to rise from the starting to the maximum brightness of seconds
+#define SECONDSFALLSTART        750  // Milliseconds into each blink where the seconds start falling back
+#define SECONDSFALLTIME          40  // Milliseconds to fall from the maximum back to the starting brightness
+
+#define CURVE_LINEAR              0  // Brightness follows the elapsed time
+#define CURVE_EASE                1  // Starts slow, ends fast (quadratic)
+#define CURVE_SMOOTH              2  // Slow at both ends (smoothstep)
+
+#define SECONDSCURVE   CURVE_LINEAR  // The shape of the seconds rise and fall
+
+// Brightness values are perceptual; led.h translates them through the gamma table in gamma.h
+#define MINUTESVALUE            160  // The brightness of minutes
+#define HOURSVALUE              160  // The brightness of hours
+#define QUARTERVALUE             72  // The brightness of the quarters
+#define SECONDSMINVALUE          21  // The starting brightness of seconds
+#define SECONDSMAXVALUE          99  // The maximum brightness of seconds
 
-#define MINUTESVALUE             92  // The brightness of minutes
-#define HOURSVALUE               92  // The brightness of hours
-#define QUARTERVALUE             16  // The brightness of the quarters
-#define SECONDSMINVALUE           1  // The starting brightness of seconds
-#define SECONDSMAXVALUE          32  // The maximum brightness of seconds
+#define HOURSCOLOR              packColor(HOURSVALUE, 0, 0)
+#define MINUTESCOLOR            packColor(0, 0, MINUTESVALUE)
+#define QUARTERCOLOR            packColor(QUARTERVALUE, QUARTERVALUE, 0)
+#define FAULTCOLOR              packColor(QUARTERVALUE, 0, 0)   // The quarters while the RTC is away
 
 /*
-#define MINUTESVALUE              4  // The brightness of minutes
-#define HOURSVALUE                4  // The brightness of hours
-#define QUARTERVALUE              4  // The brightness of the quarters
-#define SECONDSMINVALUE           1  // The starting brightness of seconds
-#define SECONDSMAXVALUE          16  // The maximum brightness of seconds
+#define MINUTESVALUE             38  // The brightness of minutes
+#define HOURSVALUE               38  // The brightness of hours
+#define QUARTERVALUE             38  // The brightness of the quarters
+#define SECONDSMINVALUE          21  // The starting brightness of seconds
+#define SECONDSMAXVALUE          72  // The maximum brightness of seconds
 */
 
 class Clock {
 private:
-  float           risevalue = 0;
+  uint8_t         risevalue = 0;
 
   unsigned long   previousMillis = millis();
 
@@ -58,23 +77,25 @@ public:
 
 /* CLOCK BACKGROUND */
 void updateLedBackground() {
+    Color quarterColor = Current.check_RTC_OK() ? QUARTERCOLOR : FAULTCOLOR;
+
     for(uint8_t i=0; i<FastLED.size(); i++) { 
     if (  i     != hourLed    && 
           i     != minuteLed  && 
           i     != secondLed  && 
           i % 3 == 0            ) { // If the quarter led doesn't hit the seconds, minutes or hour; show it
-        LedArray.setMemoryLedRGB(i, QUARTERVALUE,QUARTERVALUE,0);        
+        LedArray.setMemoryLed(i, quarterColor);        
       } else {
-        LedArray.setMemoryLedRGB(i, 0,0,0);
+        LedArray.setMemoryLed(i, 0);
       }
     }
 }
 
 /* CLOCK PART */
 void determineLedPositions() {
-    hourLed   = Current.Hour();    
-    minuteLed = map(Current.FiveMinute(),0,60,0,12);
-    secondLed = map(Current.FiveSecond(),0,60,0,12);
+    hourLed   = Current.tick.hour12;
+    minuteLed = Current.tick.minuteLed;
+    secondLed = Current.tick.secondLed;
 
     // Handle Regular Exception; hours and minuts overlap
     hours_and_minutes_overlap   = ( hourLed   == minuteLed );     
@@ -88,15 +109,15 @@ void updateHourLed() {
 
     if ( hours_and_minutes_overlap ) {
       // Manage minutes overlapping hours
-      if ( Current.unevenSecond ) {
-        LedArray.setMemoryLedRGB(hourLed, LedArray.red[hourLed] + int(risevalue), LedArray.green[hourLed], LedArray.blue[hourLed]); 
+      if ( not Current.tick.evenSecond ) {
+        LedArray.increaseMemoryLed(hourLed, packColor(risevalue, 0, 0)); 
       }
     } else {
       // Manage hours overlapping seconds
       if ( not seconds_and_hours_overlap ) {
-        LedArray.increaseMemoryLedRGB(hourLed, HOURSVALUE, 0, 0);      
-      } else if ( (Current.Second() - Current.FiveSecond()) % 2 != 0 ) {
-        LedArray.setMemoryLedRGB(hourLed, LedArray.red[hourLed] + int(risevalue), LedArray.green[hourLed], LedArray.blue[hourLed]); 
+        LedArray.increaseMemoryLed(hourLed, HOURSCOLOR);      
+      } else if ( (Current.tick.second - Current.tick.fiveSecond) % 2 != 0 ) {
+        LedArray.increaseMemoryLed(hourLed, packColor(risevalue, 0, 0)); 
       }
     }
     
@@ -105,37 +126,54 @@ void updateHourLed() {
 void updateMinuteLed() { 
     if ( hours_and_minutes_overlap ) {
       // Manage minutes overlapping hours
-      if ( Current.evenSecond ) {
-        LedArray.setMemoryLedRGB(minuteLed, LedArray.red[minuteLed], LedArray.green[minuteLed], LedArray.blue[minuteLed] + int(risevalue) ); 
+      if ( Current.tick.evenSecond ) {
+        LedArray.increaseMemoryLed(minuteLed, packColor(0, 0, risevalue)); 
 //        LedArray.setMemoryLedRGB(minuteLed, 0, 0, MINUTESVALUE);
       }
     } else {
       // Manage minutes overlapping seconds
       if ( not seconds_and_minutes_overlap ) {
-        LedArray.increaseMemoryLedRGB(minuteLed, 0, 0, MINUTESVALUE);
-      } else if ( (Current.Second() - Current.FiveSecond()) % 2 != 0 ) {
-        LedArray.setMemoryLedRGB(minuteLed, LedArray.red[minuteLed], LedArray.green[minuteLed], LedArray.blue[minuteLed] + int(risevalue) ); 
+        LedArray.increaseMemoryLed(minuteLed, MINUTESCOLOR);
+      } else if ( (Current.tick.second - Current.tick.fiveSecond) % 2 != 0 ) {
+        LedArray.increaseMemoryLed(minuteLed, packColor(0, 0, risevalue)); 
 //        LedArray.setMemoryLedRGB(minuteLed, 0, 0, MINUTESVALUE);        
       }
     }
 }
 
+// Fixed point fade; only depends on the elapsed time so it looks the same at any loop speed
+uint8_t secondsFade(unsigned long elapsed) {
+  uint16_t phase = elapsed % SECONDSBLINKEACH;
+  uint8_t  level;                                   // Position on the fade; 0 = starting, 255 = maximum brightness
+
+  if ( phase < SECONDSRISETIME ) {
+    level = ( (uint32_t)phase * ( 65536UL / SECONDSRISETIME ) ) >> 8;
+  } else if ( phase < SECONDSFALLSTART ) {
+    level = 255;
+  } else if ( phase < SECONDSFALLSTART + SECONDSFALLTIME ) {
+    level = 255 - ( ( (uint32_t)(phase - SECONDSFALLSTART) * ( 65536UL / SECONDSFALLTIME ) ) >> 8 );
+  } else {
+    level = 0;
+  }
+
+#if SECONDSCURVE == CURVE_EASE
+  level = ( (uint16_t)level * level ) >> 8;
+#elif SECONDSCURVE == CURVE_SMOOTH
+  level = ( (uint32_t)( ( (uint16_t)level * level ) >> 8 ) * ( 768 - 2 * (uint16_t)level ) ) >> 8;
+#endif
+
+  return SECONDSMINVALUE + ( ( (uint16_t)( SECONDSMAXVALUE - SECONDSMINVALUE ) * level + 128 ) >> 8 );
+}
+
 void updateSecondLed() { 
   
  if ( Current.TimeChanged() ) {
     // Reset the seconds led value
-    LedArray.green[secondLed] = SECONDSMINVALUE;
-    risevalue = 0;
+    LedArray.memory[secondLed].g = SECONDSMINVALUE;
  }
 
  // Manage the dimming of the second led in it's domain
- unsigned long modDiff     = (millis() - Current.lastTimeChange ) % SECONDSBLINKEACH;
-
- if ( modDiff > (SECONDSBLINKEACH * .75) ) {
-     risevalue = constrain((risevalue - SECONDSRISE), SECONDSMINVALUE, SECONDSMAXVALUE); 
- } else {  
-     risevalue = constrain((risevalue + SECONDSRISE), SECONDSMINVALUE, SECONDSMAXVALUE); 
- }
+ risevalue = secondsFade(millis() - Current.lastTimeChange);
 
  // Always show the seconds UNLESS the Seconds, Hours and Minutes ALL overlap
  if ( ( hours_and_minutes_overlap && minutes_and_seconds_overlap ) ) {
@@ -143,18 +181,17 @@ void updateSecondLed() {
  } else {
   // Check if seconds and hours overlap or if seconds and minutes overlap
   if ( seconds_and_hours_overlap || seconds_and_minutes_overlap ) {
-    if ( (Current.Second() - Current.FiveSecond()) % 2 == 0 ) {
-      LedArray.setMemoryLedRGB(secondLed,LedArray.red[secondLed], LedArray.green[secondLed] + int(risevalue) , LedArray.blue[secondLed]); 
+    if ( (Current.tick.second - Current.tick.fiveSecond) % 2 == 0 ) {
+      LedArray.increaseMemoryLed(secondLed, packColor(0, risevalue, 0)); 
     }
   } else {
-    LedArray.setMemoryLedRGB(secondLed,LedArray.red[secondLed], LedArray.green[secondLed] + int(risevalue) , LedArray.blue[secondLed]);
+    LedArray.increaseMemoryLed(secondLed, packColor(0, risevalue, 0));
   }
  }
 
 }
 
 void displayCurrentTime() {
-  if ( Current.check_RTC_OK() ) {
     determineLedPositions();
   
     updateLedBackground();
@@ -163,26 +200,11 @@ void displayCurrentTime() {
     updateSecondLed();
     
     LedArray.activateMemory();
-  } else {
-    Serial.println(F("Resetting RTC in 10 seconds..."));
-
-    // Show Red - White for 10 secs before resetting to indicate issues
-    for ( uint8_t i = 0 ; i < 20 ; i++ ) {
-     if ( i % 2 == 0 ) {
-       FastLED.showColor(CRGB(160, 255, 255));
-     } else {   
-       FastLED.showColor(CRGB(255, 0, 0));
-     }
-     delay(500);
-   }
-    Current.reset_RTC();
-  }
 }
 
 void update() {
-    Current.getTime();
     displayCurrentTime();
-    FastLED.show();
+    LedArray.show();
 }
 
 };
@@ -0,0 +1,45 @@
+/*
+ * Color Library  (Uses the FastLED library for CRGB)
+ *
+ * Color math on whole pixels. A pixel is packed in a 32 bit value as 0x00RRGGBB and every operation works
+ * on all three channels at once (SWAR; SIMD within a register) instead of three separate byte operations.
+ * Results never wrap around: adding to a bright channel stops at 255 instead of turning dim.
+ *
+ *  Functions:
+ *    packColor()       -- Pack r, g, b (or a CRGB) into a Color
+ *    unpackColor()     -- Unpack a Color into a CRGB
+ *
+ *    colorAdd()        -- Saturating add of two colors; every channel stops at 255
+ *
+ */
+
+#include "FastLED.h"
+
+typedef uint32_t Color;
+
+#define COLOR_LOW7        0x007F7F7FUL  // The lower 7 bits of every channel
+#define COLOR_HIGH        0x00808080UL  // The top bit of every channel
+
+inline Color packColor(uint8_t r, uint8_t g, uint8_t b) {
+  return ( (Color)r << 16 ) | ( (Color)g << 8 ) | b;
+}
+
+inline Color packColor(const CRGB &c) {
+  return packColor(c.r, c.g, c.b);
+}
+
+inline CRGB unpackColor(Color c) {
+  return CRGB(c >> 16, c >> 8, c);
+}
+
+inline Color colorAdd(Color a, Color b) {
+  // Add the lower 7 bits of every channel; that can't carry into the next channel
+  Color sum   = ( a & COLOR_LOW7 ) + ( b & COLOR_LOW7 );
+  // A channel overflows when both top bits are set, or one is set and the 7 bit sum carried into it
+  Color carry = ( ( a & b ) | ( ( a ^ b ) & sum ) ) & COLOR_HIGH;
+
+  sum ^= ( a ^ b ) & COLOR_HIGH;
+
+  // Turn every carry bit into 0xFF for its channel: 0x80 << 1 = 0x100, minus 0x01 = 0xFF
+  return sum | ( ( carry << 1 ) - ( carry >> 7 ) );
+}
@@ -0,0 +1,56 @@
+/*
+ * Gamma Library
+ * 
+ * The WS2812's output brightness is linear in the value sent, our eyes are not. Colors in the LED memory are
+ * perceptual values (0..255) and get translated to output values when the memory is activated (see led.h).
+ * 
+ * gamma16[] holds 255 * (v / 255) ^ 2.2 in 8.8 fixed point with LEDBRIGHTNESS already folded in, so the
+ * translation is one flash lookup per channel and the brightness scaling doesn't quantize a second time.
+ * The fraction is kept for temporal dithering: dark values alternate between the two nearest output
+ * levels across frames instead of sticking to one visible step.
+ * 
+ * The table lives in flash (PROGMEM); read it through pgm_read_word().
+ * 
+ *  Regenerate the numbers with:
+ *    python3 -c "print([round(255 * ((i / 255) ** 2.2) * 256) for i in range(256)])"
+ * 
+ */
+
+#define G(v)   ( (uint16_t)( ( (uint32_t)(v) * ( LEDBRIGHTNESS + 1 ) ) >> 8 ) )
+
+const uint16_t gamma16[256] PROGMEM = {
+  G(    0), G(    0), G(    2), G(    4), G(    7), G(   11), G(   17), G(   24),
+  G(   32), G(   42), G(   53), G(   65), G(   78), G(   94), G(  110), G(  128),
+  G(  148), G(  169), G(  191), G(  216), G(  241), G(  269), G(  298), G(  328),
+  G(  360), G(  394), G(  430), G(  467), G(  506), G(  547), G(  589), G(  633),
+  G(  679), G(  726), G(  776), G(  827), G(  880), G(  934), G(  991), G( 1049),
+  G( 1109), G( 1171), G( 1235), G( 1300), G( 1368), G( 1437), G( 1508), G( 1581),
+  G( 1656), G( 1733), G( 1812), G( 1893), G( 1975), G( 2060), G( 2146), G( 2235),
+  G( 2325), G( 2417), G( 2512), G( 2608), G( 2706), G( 2806), G( 2908), G( 3013),
+  G( 3119), G( 3227), G( 3337), G( 3450), G( 3564), G( 3680), G( 3798), G( 3919),
+  G( 4041), G( 4166), G( 4292), G( 4421), G( 4552), G( 4685), G( 4819), G( 4956),
+  G( 5096), G( 5237), G( 5380), G( 5525), G( 5673), G( 5823), G( 5974), G( 6128),
+  G( 6284), G( 6442), G( 6603), G( 6765), G( 6930), G( 7097), G( 7266), G( 7437),
+  G( 7610), G( 7786), G( 7963), G( 8143), G( 8325), G( 8509), G( 8696), G( 8885),
+  G( 9075), G( 9268), G( 9464), G( 9661), G( 9861), G(10063), G(10267), G(10474),
+  G(10682), G(10893), G(11107), G(11322), G(11540), G(11760), G(11982), G(12207),
+  G(12433), G(12663), G(12894), G(13128), G(13363), G(13602), G(13842), G(14085),
+  G(14330), G(14578), G(14827), G(15080), G(15334), G(15591), G(15850), G(16111),
+  G(16375), G(16641), G(16909), G(17180), G(17453), G(17729), G(18006), G(18287),
+  G(18569), G(18854), G(19141), G(19431), G(19723), G(20017), G(20314), G(20613),
+  G(20915), G(21218), G(21525), G(21833), G(22144), G(22458), G(22774), G(23092),
+  G(23413), G(23736), G(24062), G(24390), G(24720), G(25053), G(25388), G(25726),
+  G(26066), G(26408), G(26753), G(27101), G(27451), G(27803), G(28158), G(28515),
+  G(28875), G(29237), G(29602), G(29969), G(30338), G(30710), G(31085), G(31462),
+  G(31841), G(32223), G(32608), G(32995), G(33384), G(33776), G(34170), G(34567),
+  G(34967), G(35369), G(35773), G(36180), G(36589), G(37001), G(37416), G(37833),
+  G(38252), G(38674), G(39099), G(39526), G(39956), G(40388), G(40823), G(41260),
+  G(41700), G(42142), G(42587), G(43034), G(43484), G(43937), G(44392), G(44849),
+  G(45310), G(45772), G(46238), G(46706), G(47176), G(47649), G(48125), G(48603),
+  G(49084), G(49567), G(50053), G(50542), G(51033), G(51526), G(52023), G(52522),
+  G(53023), G(53527), G(54034), G(54543), G(55055), G(55570), G(56087), G(56607),
+  G(57129), G(57654), G(58182), G(58712), G(59245), G(59780), G(60318), G(60859),
+  G(61402), G(61948), G(62497), G(63048), G(63602), G(64159), G(64718), G(65280)
+};
+
+#undef G
@@ -5,17 +5,39 @@
  * 1. Through the memory which enables adding colours to each other on the same LED
  * 2. Immediately setting the color to the LED
  * 
+ * The memory holds the colors as composed; led_color is the frame FastLED renders from. activateMemory() writes
+ * the output value of a memory color into led_color only where it changed.
+ * 
  *  Functions: 
  *    init()                  -- Initialize the Neopixels
  *    setMemoryLedRGB()       -- Setting the Memory address of a specific LED with the color value
  *    getMemoryLedRGB()       -- Getting the content of a Memory address countaining the color value of a specific LED
- *    increaseMemoryLedRGB()  -- Adding Color values to another
+ *    increaseMemoryLedRGB()  -- Adding Color values to another (saturating; see color.h)
+ *    setMemoryLed()          -- Setting the Memory address of a specific LED with a packed Color
+ *    increaseMemoryLed()     -- Adding a packed Color to the Memory address of a specific LED (saturating)
  *    
+ *    output()                -- Translating a perceptual color to the output value (gamma, brightness, dithering)
  *    activateMemory()        -- Applying the memory color values to the LED's
+ *    show()                  -- Pushing the LED's to the strip; skipped when no LED changed since the last push
+ *    retry()                 -- Pushing a frame show() held back, once that's allowed
  *    
  *    setLedRGB()             -- Immediately setting the color value of a specific LED
+ *    setLed()                -- Immediately setting a packed Color to a specific LED
+ *    setLedMask()            -- Immediately setting the LED's of a bitmask frame to one color and the others to another
+ *    setLedFrame()           -- Immediately setting all LED's from a color frame stored in flash (PROGMEM)
+ *    showColor()             -- Immediately showing a single color on all LED's
  *    setAllOff()             -- Immediately disabling all LED's
  *    
+ * Memory colors are perceptual values. activateMemory() translates them through the gamma / brightness table
+ * in gamma.h (flash; one lookup per channel) so dark fades get evenly spaced steps, and can dither the
+ * remaining fraction over frames (LEDDITHER). Immediately set colors go through the same table (rounded),
+ * so a color looks the same either way. FastLED itself runs at full brightness without dithering.
+ * 
+ * Every LED that gets a new color is flagged in a changed mask. Pushing a frame to the WS2812's disables
+ * interrupts (~30 us per LED) which also corrupts bytes arriving from the MP3 player, so show() only pushes
+ * when the mask isn't empty. framesPushed / framesSkipped count how often that paid off. While serial bytes are
+ * expected the push waits for the arbiter (arbiter.h); the frame stays changed and goes out on a later show().
+ *    
  */
  
 // Pin's connected
@@ -26,6 +48,9 @@
 
 #define LEDBRIGHTNESS           128
 
+#define LEDDITHER                 0  // Temporal dithering of dark memory colors (pushes a frame each dither step)
+#define LEDDITHERTIME             2  // Milliseconds per dither step; 8 steps per cycle
+
 // The amount of leds used
 #define NUM_LEDS 12
 
@@ -34,13 +59,34 @@
 // Clock pin only needed for SPI based chipsets when not using hardware SPI
 //#define CLOCK_PIN 8
 
+#include "./gamma.h"
+
+#if LEDDITHER
+// Bit reversed thresholds; spreads the on-frames of every fraction evenly over the cycle
+const uint8_t ditherThreshold[8] PROGMEM = { 16, 144, 80, 208, 48, 176, 112, 240 };
+#endif
+
+// One LED of a color frame; frames are NUM_LEDS of these in flash (see patterns.h)
+struct FrameColor {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+};
+
 class Led {
 public:
-  uint8_t red[NUM_LEDS];
-  uint8_t green[NUM_LEDS];
-  uint8_t blue[NUM_LEDS];
-  
-  CRGB led_color[NUM_LEDS];
+  CRGB  memory[NUM_LEDS];               // The frame being composed
+  CRGB  led_color[NUM_LEDS];            // The frame FastLED renders from
+
+#if LEDDITHER
+  uint8_t       ditherStep    = 0;
+  unsigned long ditherTime    = 0;
+#endif
+
+  uint16_t      changed       = 0;      // Bit per LED that changed since the last push
+  bool          held          = false;  // show() held a frame back for the arbiter
+  unsigned long framesPushed  = 0;
+  unsigned long framesSkipped = 0;
 
 void init() {  
   Serial.println(F("Initializing LED's..."));  
@@ -68,53 +114,148 @@ void init() {
   // FastLED.addLeds<WS2801, DATA_PIN, CLOCK_PIN, RGB>(leds, NUM_LEDS);
   // FastLED.addLeds<SM16716, DATA_PIN, CLOCK_PIN, RGB>(leds, NUM_LEDS);
   // FastLED.addLeds<LPD8806, DATA_PIN, CLOCK_PIN, RGB>(leds, NUM_LEDS);
-  FastLED.setBrightness(LEDBRIGHTNESS);
+  // The brightness is applied by output(); FastLED would quantize it a second time
+  FastLED.setBrightness(255);
+  FastLED.setDither(DISABLE_DITHER);
+}
+
+// Translate a perceptual color to the output value for the strip; threshold 128 rounds, others dither
+CRGB output(const CRGB &color, uint8_t threshold) {
+  return CRGB( ( pgm_read_word(&gamma16[color.r]) + threshold ) >> 8,
+               ( pgm_read_word(&gamma16[color.g]) + threshold ) >> 8,
+               ( pgm_read_word(&gamma16[color.b]) + threshold ) >> 8 );
 }
 
 /* LED & Memory management */
 // Set the led color in the memory
 void setMemoryLedRGB(uint8_t l, uint8_t r, uint8_t g, uint8_t b) {
-  red[l]    = r;
-  green[l]  = g;
-  blue[l]   = b;
+  memory[l] = CRGB(r, g, b);
 }
 
 // Get the color value set in memory for the led
 uint8_t getMemoryLedRGB(uint8_t l, char color ) {
   switch ( color ) {
     case 'r': 
-      return red[l];
+      return memory[l].r;
     break;
     case 'g': 
-      return green[l];
+      return memory[l].g;
     break;
     case 'b': 
-      return blue[l];
+      return memory[l].b;
     break;
   }
+  return 0;
 }
 
 // Add a value to the existing value in the memory block
 void increaseMemoryLedRGB(uint8_t l, uint8_t r, uint8_t g, uint8_t b) {
-  red[l]    = red[l]   + r;
-  green[l]  = green[l] + g;
-  blue[l]   = blue[l]  + b;
+  increaseMemoryLed(l, packColor(r, g, b));
+}
+
+void setMemoryLed(uint8_t l, Color c) {
+  memory[l] = unpackColor(c);
+}
+
+void increaseMemoryLed(uint8_t l, Color c) {
+  memory[l] = unpackColor(colorAdd(packColor(memory[l]), c));
 }
 
 // Immediately set the value of a let
 void setLedRGB(uint8_t l, uint8_t r, uint8_t g, uint8_t b) {
-  led_color[l] = CRGB(r, g, b);
+  setLed(l, packColor(r, g, b));
+}
+
+void setLed(uint8_t l, Color c) {
+  CRGB color = output(unpackColor(c), 128);
+  
+  if ( led_color[l] != color ) {
+    led_color[l] = color;
+    changed     |= ( 1 << l );
+  }
+}
+
+// Bit n of the mask is led n; both colors are translated once for the whole frame
+void setLedMask(uint16_t mask, Color on, Color off) {
+  CRGB onColor  = output(unpackColor(on), 128);
+  CRGB offColor = output(unpackColor(off), 128);
+
+  for(uint8_t l=0; l<NUM_LEDS; l++, mask >>= 1) {
+    const CRGB &color = ( mask & 1 ) ? onColor : offColor;
+    
+    if ( led_color[l] != color ) {
+      led_color[l] = color;
+      changed     |= ( 1 << l );
+    }
+  }
+}
+
+// Stream a color frame of NUM_LEDS FrameColors from flash
+void setLedFrame(const FrameColor *frame) {
+  for(uint8_t l=0; l<NUM_LEDS; l++, frame++) {
+    setLedRGB(l, pgm_read_byte(&frame->r), pgm_read_byte(&frame->g), pgm_read_byte(&frame->b));
+  }
+}
+
+// Show one color on all leds; the strip doesn't match led_color anymore afterwards
+void showColor(uint8_t r, uint8_t g, uint8_t b) {
+  FastLED.showColor(output(CRGB(r, g, b), 128));
+  changed = ( 1 << NUM_LEDS ) - 1;
+  framesPushed++;
 }
 
 void setAllOff() {
-  FastLED.showColor(CRGB(0, 0, 0));
+  showColor(0, 0, 0);
 }
 
 /* ACTIVATING THE MEMORY TO THE LEDS */
+// Every memory color is translated to its output value on the fly; only the leds whose output value changed are
+// written to the strip frame. The memory frame isn't touched, so getMemoryLedRGB() keeps returning the composed
+// (perceptual) colors.
 void activateMemory() {
-    for(uint16_t i=0; i<FastLED.size(); i++) {
-          setLedRGB(i, red[i], green[i], blue[i]);
+    uint16_t difference = 0;
+    uint8_t  threshold  = 128;            // Round to the nearest output value
+
+#if LEDDITHER
+    if ( millis() - ditherTime >= LEDDITHERTIME ) {
+      ditherTime = millis();
+      ditherStep = ( ditherStep + 1 ) & 7;
+    }
+    threshold = pgm_read_byte(&ditherThreshold[ditherStep]);
+#endif
+    
+    for(uint8_t i=0; i<NUM_LEDS; i++) {
+      CRGB color = output(memory[i], threshold);
+      
+      if ( color != led_color[i] ) {
+        led_color[i] = color;
+        difference  |= ( 1 << i );
+      }
+    }
+
+    changed |= difference;
+}
+
+// Push the leds to the strip when any of them changed
+void show() {
+  if ( changed ) {
+    if ( not LedArbiter.allow() ) {
+      held = true;                        // Serial bytes are coming in; changed stays set
+      return;
     }
+    held = false;
+    FastLED.show();
+    changed = 0;
+    framesPushed++;
+  } else {
+    framesSkipped++;
+  }
+}
+
+void retry() {
+  if ( held ) {
+    show();
+  }
 }
 
 };
@@ -3,14 +3,33 @@
  * 
  * Mainly used to show different patterns for some nice / funny effects
  * 
+ * Patterns don't block; starting one only registers it with LedPatterns. The loop calls LedPatterns.update()
+ * which renders at most one frame of the running pattern when that frame is due and returns immediately
+ * otherwise, so the clock, speech and serial input keep being serviced while an animation runs.
+ * Starting a pattern while another one is running queues it until the running one is done.
+ * 
  *  Functions:
  *    Intro()           -- The LEDS will show all yellow lighted and will move to 4 Quarters showing only 
  *    QuarterChange()   -- The LEDS will indicate 4 turning Quarters meaning a quarter has passed
  *    RandomLedColors() -- All of the LED's will show random colors - at random
  *    RGBShow()         -- The LEDS always start showing blue when activated; this pattern will show Green and Blue too
  *    
+ *    Smiley()          -- Show a smiley for a few seconds
  *    Vu()              -- A pattern that could be a start for something like a VU meter
  *    
+ *  Pattern frames:
+ *    Frames are declared at compile time and stored in flash (PROGMEM) so a pattern costs flash instead of SRAM
+ *    ledMask()         -- A bitmask frame with the given leds lit; bit n is led n   (constexpr)
+ *    rotateMask()      -- A bitmask frame turned a number of leds clockwise         (constexpr)
+ *    frameColor()      -- One led of a color frame                                  (constexpr)
+ *    Bitmask frames are drawn with LedArray.setLedMask(), color frames with LedArray.setLedFrame()
+ *    
+ *  Pattern class:
+ *    start()           -- Start a pattern (or queue it when one is running)
+ *    stop()            -- Stop the running pattern and forget the queued one
+ *    running()         -- Whether a pattern is running
+ *    update()          -- Render the next frame of the running pattern when it is due; returns running()
+ *    
  */
   
   
@@ -18,160 +37,254 @@
 #define QUARTERPATTERNTIMEOUT  5000  // How long should the quarter pattern show
 #define HOURPATTERNTIMEOUT    20000  // How long should the hour pattern show
 
-void Intro() {
-  uint16_t ledintro[] = {
-                            0B0000111111111111,
-                            0B0000101101101101,
-                            0B0000001001001001
-                          };
+#define PATTERN_NONE              0
+#define PATTERN_RGBSHOW           1
+#define PATTERN_INTRO             2
+#define PATTERN_QUARTER           3
+#define PATTERN_RANDOM            4
+#define PATTERN_SMILEY            5
+#define PATTERN_VU                6
 
-  LedArray.setAllOff();
-  
-  for( uint8_t l=0; l < 3 ; l++ ) {
-    int counter = 0;
-    
-    for(uint16_t mask=1; counter <= 11 ; mask <<=1) {
-            if ( mask & ledintro[l] ) {
-              //Serial.println("Showing yellow for led: " + String(counter));
-              LedArray.setLedRGB(counter, QUARTERVALUE, QUARTERVALUE, 0);
-            } else {
-              //Serial.println("Showing black for led: " + String(counter));
-              LedArray.setLedRGB(counter, 0, 0, 0);            
-            }
-            counter++;
-    }
-    FastLED.show();
-    delay(3000);
-  }  
+#define PATTERN_DONE              0  // Returned by a step when the pattern has no frames left
+
+/* PATTERN FRAMES */
+constexpr uint16_t ledMask() {
+  return 0;
 }
 
-void QuarterChange(unsigned long TimeOut) {
-  uint16_t ledintro[] = {
-                            0B0000111000111000,
-                            0B0000110001110001,
-                            0B0000100011100011,
-                            0B0000000111000111,
-                            0B0000001110001110,
-                            0B0000011100011100
-                          };
-                          
-
-  LedArray.setAllOff();
-
-  unsigned long startTime = millis();
-  
-  while ( millis() - startTime < TimeOut ) {
-    
-    for( uint8_t l=0; l < 6 ; l++ ) {
-      int counter = 0;
-      
-      for(uint16_t mask=1; counter <= 11 ; mask <<=1) {
-              if ( mask & ledintro[l] ) {
-                //Serial.println("Showing yellow for led: " + String(counter));
-                LedArray.setLedRGB(counter, 0, 0, MINUTESVALUE);
-              } else {
-                //Serial.println("Showing black for led: " + String(counter));
-                LedArray.setLedRGB(counter, HOURSVALUE, 0, 0);            
-              }
-              counter++;
-      }
-      FastLED.show();
-      delay(100);
-    }  
-  }  
+template<typename... Leds>
+constexpr uint16_t ledMask(uint8_t led, Leds... leds) {
+  return ( 1 << led ) | ledMask(leds...);
 }
 
+constexpr uint16_t rotateMask(uint16_t mask, uint8_t steps) {
+  return ( ( mask << steps ) | ( mask >> ( NUM_LEDS - steps ) ) ) & ( ( 1 << NUM_LEDS ) - 1 );
+}
 
-void RandomLedColors(unsigned long TimeOut) {
-  //LedArray.setAllOff();
-  unsigned long startTime = millis();
-  
-  while ( millis() - startTime < TimeOut ) {
-      uint8_t i=random(0,12),r=random(0,128),g=random(0,128),b=random(0,128);
-
-      //Serial.println("LED: "+ String(i) + " - r:" + String(r) + " - g:" + String(g) + " - b:" + String(b));
-      
-      LedArray.setLedRGB(i,r,g,b);
-      FastLED.show();
-      delay(100);
-  }
-  
+constexpr FrameColor frameColor(uint8_t r, uint8_t g, uint8_t b) {
+  return FrameColor{ r, g, b };
 }
 
+#define FRAMES(frames)    ( sizeof(frames) / sizeof(frames[0]) )
 
-void RGBShow() {
-  // Blue is the default starting color; ingoring that...
-  FastLED.showColor(CRGB(128, 0, 0));
-  delay(2000);
-  FastLED.showColor(CRGB(0, 128, 0));
-  delay(2000);
-}
+const uint16_t introFrames[] PROGMEM = {
+  ledMask(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11),
+  ledMask(0, 2, 3, 5, 6, 8, 9, 11),
+  ledMask(0, 3, 6, 9)
+};
 
-void Smiley() {
-  uint8_t showleds[] = { 1,4,5,6,7,8,11 };
+// Two thirds of the dial in blue, turning one led per frame
+#define QUARTERMASK       ledMask(3, 4, 5, 9, 10, 11)
 
-  for(uint8_t i=0; i < sizeof(showleds); i++) {
-     LedArray.setLedRGB(showleds[i], 128, 128, 0);
-  }
+const uint16_t quarterFrames[] PROGMEM = {
+  rotateMask(QUARTERMASK, 0),
+  rotateMask(QUARTERMASK, 1),
+  rotateMask(QUARTERMASK, 2),
+  rotateMask(QUARTERMASK, 3),
+  rotateMask(QUARTERMASK, 4),
+  rotateMask(QUARTERMASK, 5)
+};
+
+const uint16_t smileyFrames[] PROGMEM = {
+  ledMask(1, 4, 5, 6, 7, 8, 11)
+};
 
-  FastLED.show();
-  delay(5000);
+// The VU meter grows from led 6 outwards, one led on each side per frame; led 0 comes last
+constexpr uint8_t vuStep(uint8_t led) {
+  return ( led == 0 ) ? 6 : ( led > 6 ? led - 6 : 6 - led );
 }
 
+constexpr FrameColor vuStepColor(uint8_t step) {
+  return step == 0 ? frameColor(136, 164, 164) :
+         step == 1 ? frameColor(  0, 136, 136) :
+         step == 2 ? frameColor(  0,   0, 136) :
+         step == 3 ? frameColor( 99, 136,  99) :
+         step == 4 ? frameColor(136, 136,   0) :
+         step == 5 ? frameColor(136,   0, 136) :
+                     frameColor(136,  72,  72);
+}
 
-void Vu() {
-  #define STEP1 = { 6 }
-  #define STEP2 = { 5,6,7 };
-  #define STEP3 = { 4,5,6,7,8 };
-  #define STEP4 = { 3,4,5,6,7,8,9 };
-  #define STEP5 = { 2,3,4,5,6,7,8,9,10 };
-  #define STEP6 = { 1,2,3,4,5,6,7,8,9,10,11 };
-  #define STEP7 = { 1,2,3,4,5,6,7,8,9,10,11,12 };
+constexpr FrameColor vuColor(uint8_t frame, uint8_t led) {
+  return vuStep(led) <= frame ? vuStepColor(vuStep(led)) : frameColor(0, 0, 0);
+}
 
-/*
-  for(uint8_t i=0; i < sizeof(showleds[]); i++) {
-     setLedRGB(showleds[i], 128, 128, 0);
+#define VUFRAME(f)  { vuColor(f, 0), vuColor(f, 1), vuColor(f, 2), vuColor(f, 3), vuColor(f, 4),  vuColor(f, 5), \
+                      vuColor(f, 6), vuColor(f, 7), vuColor(f, 8), vuColor(f, 9), vuColor(f, 10), vuColor(f, 11) }
+
+const FrameColor vuFrames[][NUM_LEDS] PROGMEM = {
+  VUFRAME(0), VUFRAME(1), VUFRAME(2), VUFRAME(3), VUFRAME(4), VUFRAME(5), VUFRAME(6)
+};
+
+class Pattern {
+private:
+  uint8_t         Active          = PATTERN_NONE;
+  uint8_t         Queued          = PATTERN_NONE;
+  unsigned long   QueuedTimeOut   = 0;
+
+  uint8_t         Step            = 0;
+  unsigned long   StartTime       = 0;
+  unsigned long   TimeOut         = 0;
+  unsigned long   StepTime        = 0;      // When the last frame was shown
+  unsigned long   StepDelay       = 0;      // How long the last frame should stay
+
+  void begin(uint8_t pattern, unsigned long timeout) {
+    Active    = pattern;
+    TimeOut   = timeout;
+    Step      = 0;
+    StartTime = millis();
+    StepTime  = StartTime;
+    StepDelay = 0;
   }
-*/
-  uint8_t plusone = 6, minusone = 6;  
 
-  for (uint8_t i=0; i < 7 ; i++ ) {
-    
-    switch ( i ) {
+  bool timedOut() {
+    return ( millis() - StartTime >= TimeOut );
+  }
+
+  // Each step shows one frame and returns how long that frame should stay
+  unsigned long stepRGBShow() {
+    // Blue is the default starting color; ingoring that...
+    switch ( Step ) {
       case 0:
-        LedArray.setLedRGB(plusone, 64, 96, 96);       //  6 
-        break;
+        LedArray.showColor(186, 0, 0);
+        return 2000;
       case 1:
-        LedArray.setLedRGB(++plusone, 0, 64, 64);    //  7
-        LedArray.setLedRGB(--minusone, 0, 64, 64);   //  5
-        break;
-      case 2:
-        LedArray.setLedRGB(++plusone, 0, 0, 64);    //  8
-        LedArray.setLedRGB(--minusone, 0, 0, 64);   //  4
-        break;
-      case 3:
-        LedArray.setLedRGB(++plusone, 32, 64, 32);   //  9
-        LedArray.setLedRGB(--minusone, 32, 64, 32);  //  3
-        break;
-      case 4:
-        LedArray.setLedRGB(++plusone, 64, 64, 0);    //  10
-        LedArray.setLedRGB(--minusone, 64, 64, 0);   //  2
-        break;
-      case 5:
-        LedArray.setLedRGB(++plusone, 64, 0, 64);   //  11
-        LedArray.setLedRGB(--minusone, 64, 0, 64);  //  1
-        break;
-      case 6:
-        LedArray.setLedRGB(--minusone, 64, 16, 16);   //  0
-        break;        
-      default:
-        // nothing
-      break;  
+        LedArray.showColor(0, 186, 0);
+        return 2000;
     }
-    
-    delay(1000);
-    FastLED.show();
+    return PATTERN_DONE;
+  }
+
+  unsigned long stepIntro() {
+    if ( Step >= FRAMES(introFrames) ) { return PATTERN_DONE; }
+
+    LedArray.setLedMask(pgm_read_word(&introFrames[Step]), QUARTERCOLOR, 0);
+    LedArray.show();
+    return 3000;
+  }
+
+  unsigned long stepQuarterChange() {
+    uint8_t l = Step % FRAMES(quarterFrames);
+
+    // Only stop after a full turn
+    if ( l == 0 && timedOut() ) { return PATTERN_DONE; }
+
+    LedArray.setLedMask(pgm_read_word(&quarterFrames[l]), MINUTESCOLOR, HOURSCOLOR);
+    LedArray.show();
+    return 100;
+  }
+
+  unsigned long stepRandomLedColors() {
+    if ( timedOut() ) { return PATTERN_DONE; }
+
+    uint8_t i=random(0,12),r=random(0,186),g=random(0,186),b=random(0,186);
+
+    LedArray.setLedRGB(i,r,g,b);
+    LedArray.show();
+    return 100;
+  }
+
+  unsigned long stepSmiley() {
+    if ( Step >= FRAMES(smileyFrames) ) { return PATTERN_DONE; }
+
+    LedArray.setLedMask(pgm_read_word(&smileyFrames[Step]), packColor(186, 186, 0), 0);
+    LedArray.show();
+    return 5000;
+  }
+
+  unsigned long stepVu() {
+    if ( Step >= FRAMES(vuFrames) ) { return PATTERN_DONE; }
+
+    LedArray.setLedFrame(vuFrames[Step]);
+    LedArray.show();
+    return 1000;
+  }
+
+  unsigned long step() {
+    switch ( Active ) {
+      case PATTERN_RGBSHOW:   return stepRGBShow();
+      case PATTERN_INTRO:     return stepIntro();
+      case PATTERN_QUARTER:   return stepQuarterChange();
+      case PATTERN_RANDOM:    return stepRandomLedColors();
+      case PATTERN_SMILEY:    return stepSmiley();
+      case PATTERN_VU:        return stepVu();
+    }
+    return PATTERN_DONE;
+  }
+
+public:
+
+void start(uint8_t pattern, unsigned long timeout = 0) {
+  if ( running() ) {
+    Queued        = pattern;
+    QueuedTimeOut = timeout;
+  } else {
+    begin(pattern, timeout);
   }
-  
 }
 
+void stop() {
+  Active = PATTERN_NONE;
+  Queued = PATTERN_NONE;
+}
+
+bool running() {
+  return ( Active != PATTERN_NONE );
+}
+
+bool update() {
+  if ( not running() ) {
+    return false;
+  }
+
+  // Leave the loop to the others until the current frame has been shown long enough
+  if ( millis() - StepTime < StepDelay ) {
+    LedArray.retry();                 // The frame may have been held back (arbiter.h)
+    return true;
+  }
+
+  StepTime  = millis();
+  StepDelay = step();
+
+  if ( StepDelay == PATTERN_DONE ) {
+    Active = PATTERN_NONE;
+
+    if ( Queued != PATTERN_NONE ) {
+      begin(Queued, QueuedTimeOut);
+      Queued = PATTERN_NONE;
+    }
+    return running();
+  }
+
+  Step++;
+  return true;
+}
+
+};
+
+Pattern LedPatterns;
+
+
+void Intro() {
+  LedPatterns.start(PATTERN_INTRO);
+}
+
+void QuarterChange(unsigned long TimeOut) {
+  LedPatterns.start(PATTERN_QUARTER, TimeOut);
+}
+
+void RandomLedColors(unsigned long TimeOut) {
+  //LedArray.setAllOff();
+  LedPatterns.start(PATTERN_RANDOM, TimeOut);
+}
+
+void RGBShow() {
+  LedPatterns.start(PATTERN_RGBSHOW);
+}
+
+void Smiley() {
+  LedPatterns.start(PATTERN_SMILEY);
+}
+
+void Vu() {
+  LedPatterns.start(PATTERN_VU);
+}
@@ -0,0 +1,186 @@
+/*
+ * Persist Library  (Uses the RTClib or the EEPROM library)
+ *
+ * Keeps the clock state that has to survive a power cycle: the DST state and the drift calibration of the
+ * internal clock. PERSISTBACKEND selects where it is stored:
+ *
+ * PERSIST_NVRAM  -- The 56 bytes of battery backed RAM in the DS1307 (default)
+ *                   The state lives and dies with the time it belongs to (swapping the RTC module takes both),
+ *                   doesn't wear and a record is read or written in a single I2C transaction.
+ * PERSIST_EEPROM -- The EEPROM of the Nano
+ *                   An EEPROM cell lasts ~100k writes and every written byte stalls the CPU for ~3.3 ms, so the
+ *                   records go round a ring to spread the wear.
+ *
+ * Both keep a ring of records with a sequence number and a CRC; at boot the valid record with the newest
+ * sequence wins. A record is only written when the state changed, the next slot of the ring is used and
+ * the written record is read back; when it doesn't verify the slot after it is tried, but never the slot of
+ * the newest record. On the NVRAM the ring is two records, so a write that is cut short by a power loss or
+ * doesn't verify leaves the previous record intact.
+ *
+ * When the ring holds no valid record yet the DST byte of the old EEPROM layout is taken over.
+ *
+ *  Functions:
+ *    init()            -- Find the newest valid record in the ring
+ *    dst()             -- The stored DST state; PERSIST_NONE when nothing is stored
+ *    setDST()          -- Store the DST state
+ *    drift()           -- The stored drift of the internal clock
+ *    setDrift()        -- Store the drift of the internal clock
+ *
+ *    crc8()            -- Dallas/Maxim CRC-8 (reflected 0x31) over a block of bytes
+ *    readRecord()      -- Read a record from the ring and check its CRC
+ *    writeRecord()     -- Write the state to the next record of the ring and verify it
+ *
+ */
+
+#include <stddef.h>
+#include <EEPROM.h>
+#include "RTClib.h"
+
+#define PERSIST_NVRAM             0
+#define PERSIST_EEPROM            1
+
+#define PERSISTBACKEND    PERSIST_NVRAM
+
+#if PERSISTBACKEND == PERSIST_NVRAM
+#define PERSISTBASE               0  // First NVRAM address of the ring (0..55)
+#define PERSISTRECORDS            2  // Records in the ring; the previous one survives an interrupted write
+#else
+#define PERSISTBASE              16  // First EEPROM address of the ring
+#define PERSISTRECORDS           32  // Records in the ring; each record takes the wear of 1/32 of the writes
+#endif
+#define PERSISTRETRIES            3  // Records tried when a written record doesn't read back
+
+#define PERSIST_NONE           0xFF  // Returned when no state is stored
+
+#define EEPROM_LEGACY_DST         0  // Where the DST state was stored before the ring
+
+struct PersistRecord {
+  uint16_t sequence;                 // Incremented on every write; the newest record wins
+  int16_t  drift;                    // Drift calibration of the internal clock
+  uint8_t  dst;
+  uint8_t  crc;                      // CRC-8 over the fields above
+};
+
+#define PERSISTCRCSIZE    offsetof(PersistRecord, crc)
+
+class Persist {
+private:
+#if PERSISTBACKEND == PERSIST_NVRAM
+  RTC_DS1307      RTC;
+#endif
+
+  PersistRecord   current;           // The newest record
+  uint8_t         slot    = PERSISTRECORDS - 1;  // Where it is stored; the next write goes to the slot after
+  bool            valid   = false;
+
+  // Starts at 0xFF so neither an erased (0xFF) nor a zeroed record passes as valid
+  uint8_t crc8(const uint8_t *data, uint8_t length) {
+    uint8_t crc = 0xFF;
+
+    while ( length-- ) {
+      crc ^= *data++;
+      for ( uint8_t i = 0; i < 8; i++ ) {
+        crc = ( crc & 1 ) ? ( crc >> 1 ) ^ 0x8C : ( crc >> 1 );
+      }
+    }
+    return crc;
+  }
+
+  int address(uint8_t s) {
+    return PERSISTBASE + s * sizeof(PersistRecord);
+  }
+
+  bool readRecord(uint8_t s, PersistRecord &record) {
+#if PERSISTBACKEND == PERSIST_NVRAM
+    RTC.readnvram((uint8_t *)&record, sizeof(record), address(s));
+#else
+    EEPROM.get(address(s), record);
+#endif
+    return ( record.crc == crc8((const uint8_t *)&record, PERSISTCRCSIZE) );
+  }
+
+  bool writeRecord(PersistRecord record) {
+    PersistRecord check;
+
+    record.sequence = current.sequence + 1;
+    record.crc      = crc8((const uint8_t *)&record, PERSISTCRCSIZE);
+
+    for ( uint8_t retry = 0; retry < PERSISTRETRIES; retry++ ) {
+      // Any slot but the one holding the newest record; on a ring of two that's the other one every time
+      uint8_t s = ( slot + 1 + retry % ( PERSISTRECORDS - 1 ) ) % PERSISTRECORDS;
+
+#if PERSISTBACKEND == PERSIST_NVRAM
+      RTC.writenvram(address(s), (uint8_t *)&record, sizeof(record));
+#else
+      EEPROM.put(address(s), record);                    // Only writes the bytes that differ
+#endif
+      writes++;
+
+      if ( readRecord(s, check) && memcmp(&check, &record, PERSISTCRCSIZE) == 0 ) {
+        current = record;
+        slot    = s;
+        valid   = true;
+        return true;
+      }
+      Serial.println(F("Stored record didn't verify; trying the next one"));
+      writeErrors++;
+    }
+    return false;
+  }
+
+public:
+  unsigned long   writes      = 0;
+  unsigned long   writeErrors = 0;
+
+void init() {
+  PersistRecord record;
+
+  valid = false;
+
+  for ( uint8_t s = 0; s < PERSISTRECORDS; s++ ) {
+    // Sequence numbers wrap around; the ring never holds records more than PERSISTRECORDS apart
+    if ( readRecord(s, record) && ( not valid || (int16_t)( record.sequence - current.sequence ) > 0 ) ) {
+      current = record;
+      slot    = s;
+      valid   = true;
+    }
+  }
+
+  if ( not valid ) {
+    // Take over the state stored by the old layout; the first change moves it into the ring
+    current.sequence = 0;
+    current.drift    = 0;
+    current.dst      = EEPROM.read(EEPROM_LEGACY_DST);
+  }
+}
+
+uint8_t dst() {
+  return ( current.dst > 1 ) ? PERSIST_NONE : current.dst;
+}
+
+void setDST(bool dst) {
+  if ( valid && current.dst == dst ) { return; }
+
+  Serial.println(F("Storing the DST state"));
+  PersistRecord record = current;
+  record.dst = dst;
+
+  writeRecord(record);
+}
+
+int16_t drift() {
+  return current.drift;
+}
+
+void setDrift(int16_t drift) {
+  if ( valid && current.drift == drift ) { return; }
+
+  PersistRecord record = current;
+  record.drift = drift;
+
+  writeRecord(record);
+}
+
+};
+
+Persist Persisted;
@@ -0,0 +1,748 @@
+/*
+ * Phrases  (Generated by phrases.py; don't edit)
+ *
+ * The words to say after "het is nu" for every time on the dial: phrases[hour12 * 60 + minute].
+ * An entry is packed by P2() .. P4(): up to four word numbers (speech.h) of PHRASEWORDBITS each, the first in the
+ * lowest bits; 0 ends the phrase.
+ *
+ * The table lives in flash (PROGMEM); read it through pgm_read_byte().
+ *
+ */
+
+#define PHRASES             720  // 12 hours of 60 minutes
+#define PHRASEBYTES           3
+#define PHRASEWORDBITS        5
+#define PHRASEWORDMASK     0x1F
+
+#define P4(a, b, c, d)  (uint8_t)( (a) | (b) << 5 ), \
+                        (uint8_t)( (b) >> 3 | (c) << 2 | (d) << 7 ), \
+                        (uint8_t)( (d) >> 1 )
+#define P3(a, b, c)     P4(a, b, c, 0)
+#define P2(a, b)        P4(a, b, 0, 0)
+
+const uint8_t phrases[PHRASES][PHRASEBYTES] PROGMEM = {
+  { P2(TWAALF, UUR)                      },  //  0:00
+  { P3(EEN, OVER, TWAALF)                },  //  0:01
+  { P3(TWEE, OVER, TWAALF)               },  //  0:02
+  { P3(DRIE, OVER, TWAALF)               },  //  0:03
+  { P3(VIER, OVER, TWAALF)               },  //  0:04
+  { P3(VIJF, OVER, TWAALF)               },  //  0:05
+  { P3(ZES, OVER, TWAALF)                },  //  0:06
+  { P3(ZEVEN, OVER, TWAALF)              },  //  0:07
+  { P3(ACHT, OVER, TWAALF)               },  //  0:08
+  { P3(NEGEN, OVER, TWAALF)              },  //  0:09
+  { P3(TIEN, OVER, TWAALF)               },  //  0:10
+  { P3(ELF, OVER, TWAALF)                },  //  0:11
+  { P3(TWAALF, OVER, TWAALF)             },  //  0:12
+  { P3(DERTIEN, OVER, TWAALF)            },  //  0:13
+  { P3(VEERTIEN, OVER, TWAALF)           },  //  0:14
+  { P3(KWART, OVER, TWAALF)              },  //  0:15
+  { P4(VEERTIEN, VOOR, HALF, EEN)        },  //  0:16
+  { P4(DERTIEN, VOOR, HALF, EEN)         },  //  0:17
+  { P4(TWAALF, VOOR, HALF, EEN)          },  //  0:18
+  { P4(ELF, VOOR, HALF, EEN)             },  //  0:19
+  { P4(TIEN, VOOR, HALF, EEN)            },  //  0:20
+  { P4(NEGEN, VOOR, HALF, EEN)           },  //  0:21
+  { P4(ACHT, VOOR, HALF, EEN)            },  //  0:22
+  { P4(ZEVEN, VOOR, HALF, EEN)           },  //  0:23
+  { P4(ZES, VOOR, HALF, EEN)             },  //  0:24
+  { P4(VIJF, VOOR, HALF, EEN)            },  //  0:25
+  { P4(VIER, VOOR, HALF, EEN)            },  //  0:26
+  { P4(DRIE, VOOR, HALF, EEN)            },  //  0:27
+  { P4(TWEE, VOOR, HALF, EEN)            },  //  0:28
+  { P4(EEN, VOOR, HALF, EEN)             },  //  0:29
+  { P2(HALF, EEN)                        },  //  0:30
+  { P4(EEN, OVER, HALF, EEN)             },  //  0:31
+  { P4(TWEE, OVER, HALF, EEN)            },  //  0:32
+  { P4(DRIE, OVER, HALF, EEN)            },  //  0:33
+  { P4(VIER, OVER, HALF, EEN)            },  //  0:34
+  { P4(VIJF, OVER, HALF, EEN)            },  //  0:35
+  { P4(ZES, OVER, HALF, EEN)             },  //  0:36
+  { P4(ZEVEN, OVER, HALF, EEN)           },  //  0:37
+  { P4(ACHT, OVER, HALF, EEN)            },  //  0:38
+  { P4(NEGEN, OVER, HALF, EEN)           },  //  0:39
+  { P4(TIEN, OVER, HALF, EEN)            },  //  0:40
+  { P4(ELF, OVER, HALF, EEN)             },  //  0:41
+  { P4(TWAALF, OVER, HALF, EEN)          },  //  0:42
+  { P4(DERTIEN, OVER, HALF, EEN)         },  //  0:43
+  { P4(VEERTIEN, OVER, HALF, EEN)        },  //  0:44
+  { P3(KWART, VOOR, EEN)                 },  //  0:45
+  { P3(VEERTIEN, VOOR, EEN)              },  //  0:46
+  { P3(DERTIEN, VOOR, EEN)               },  //  0:47
+  { P3(TWAALF, VOOR, EEN)                },  //  0:48
+  { P3(ELF, VOOR, EEN)                   },  //  0:49
+  { P3(TIEN, VOOR, EEN)                  },  //  0:50
+  { P3(NEGEN, VOOR, EEN)                 },  //  0:51
+  { P3(ACHT, VOOR, EEN)                  },  //  0:52
+  { P3(ZEVEN, VOOR, EEN)                 },  //  0:53
+  { P3(ZES, VOOR, EEN)                   },  //  0:54
+  { P3(VIJF, VOOR, EEN)                  },  //  0:55
+  { P3(VIER, VOOR, EEN)                  },  //  0:56
+  { P3(DRIE, VOOR, EEN)                  },  //  0:57
+  { P3(TWEE, VOOR, EEN)                  },  //  0:58
+  { P3(EEN, VOOR, EEN)                   },  //  0:59
+  { P2(EEN, UUR)                         },  //  1:00
+  { P3(EEN, OVER, EEN)                   },  //  1:01
+  { P3(TWEE, OVER, EEN)                  },  //  1:02
+  { P3(DRIE, OVER, EEN)                  },  //  1:03
+  { P3(VIER, OVER, EEN)                  },  //  1:04
+  { P3(VIJF, OVER, EEN)                  },  //  1:05
+  { P3(ZES, OVER, EEN)                   },  //  1:06
+  { P3(ZEVEN, OVER, EEN)                 },  //  1:07
+  { P3(ACHT, OVER, EEN)                  },  //  1:08
+  { P3(NEGEN, OVER, EEN)                 },  //  1:09
+  { P3(TIEN, OVER, EEN)                  },  //  1:10
+  { P3(ELF, OVER, EEN)                   },  //  1:11
+  { P3(TWAALF, OVER, EEN)                },  //  1:12
+  { P3(DERTIEN, OVER, EEN)               },  //  1:13
+  { P3(VEERTIEN, OVER, EEN)              },  //  1:14
+  { P3(KWART, OVER, EEN)                 },  //  1:15
+  { P4(VEERTIEN, VOOR, HALF, TWEE)       },  //  1:16
+  { P4(DERTIEN, VOOR, HALF, TWEE)        },  //  1:17
+  { P4(TWAALF, VOOR, HALF, TWEE)         },  //  1:18
+  { P4(ELF, VOOR, HALF, TWEE)            },  //  1:19
+  { P4(TIEN, VOOR, HALF, TWEE)           },  //  1:20
+  { P4(NEGEN, VOOR, HALF, TWEE)          },  //  1:21
+  { P4(ACHT, VOOR, HALF, TWEE)           },  //  1:22
+  { P4(ZEVEN, VOOR, HALF, TWEE)          },  //  1:23
+  { P4(ZES, VOOR, HALF, TWEE)            },  //  1:24
+  { P4(VIJF, VOOR, HALF, TWEE)           },  //  1:25
+  { P4(VIER, VOOR, HALF, TWEE)           },  //  1:26
+  { P4(DRIE, VOOR, HALF, TWEE)           },  //  1:27
+  { P4(TWEE, VOOR, HALF, TWEE)           },  //  1:28
+  { P4(EEN, VOOR, HALF, TWEE)            },  //  1:29
+  { P2(HALF, TWEE)                       },  //  1:30
+  { P4(EEN, OVER, HALF, TWEE)            },  //  1:31
+  { P4(TWEE, OVER, HALF, TWEE)           },  //  1:32
+  { P4(DRIE, OVER, HALF, TWEE)           },  //  1:33
+  { P4(VIER, OVER, HALF, TWEE)           },  //  1:34
+  { P4(VIJF, OVER, HALF, TWEE)           },  //  1:35
+  { P4(ZES, OVER, HALF, TWEE)            },  //  1:36
+  { P4(ZEVEN, OVER, HALF, TWEE)          },  //  1:37
+  { P4(ACHT, OVER, HALF, TWEE)           },  //  1:38
+  { P4(NEGEN, OVER, HALF, TWEE)          },  //  1:39
+  { P4(TIEN, OVER, HALF, TWEE)           },  //  1:40
+  { P4(ELF, OVER, HALF, TWEE)            },  //  1:41
+  { P4(TWAALF, OVER, HALF, TWEE)         },  //  1:42
+  { P4(DERTIEN, OVER, HALF, TWEE)        },  //  1:43
+  { P4(VEERTIEN, OVER, HALF, TWEE)       },  //  1:44
+  { P3(KWART, VOOR, TWEE)                },  //  1:45
+  { P3(VEERTIEN, VOOR, TWEE)             },  //  1:46
+  { P3(DERTIEN, VOOR, TWEE)              },  //  1:47
+  { P3(TWAALF, VOOR, TWEE)               },  //  1:48
+  { P3(ELF, VOOR, TWEE)                  },  //  1:49
+  { P3(TIEN, VOOR, TWEE)                 },  //  1:50
+  { P3(NEGEN, VOOR, TWEE)                },  //  1:51
+  { P3(ACHT, VOOR, TWEE)                 },  //  1:52
+  { P3(ZEVEN, VOOR, TWEE)                },  //  1:53
+  { P3(ZES, VOOR, TWEE)                  },  //  1:54
+  { P3(VIJF, VOOR, TWEE)                 },  //  1:55
+  { P3(VIER, VOOR, TWEE)                 },  //  1:56
+  { P3(DRIE, VOOR, TWEE)                 },  //  1:57
+  { P3(TWEE, VOOR, TWEE)                 },  //  1:58
+  { P3(EEN, VOOR, TWEE)                  },  //  1:59
+  { P2(TWEE, UUR)                        },  //  2:00
+  { P3(EEN, OVER, TWEE)                  },  //  2:01
+  { P3(TWEE, OVER, TWEE)                 },  //  2:02
+  { P3(DRIE, OVER, TWEE)                 },  //  2:03
+  { P3(VIER, OVER, TWEE)                 },  //  2:04
+  { P3(VIJF, OVER, TWEE)                 },  //  2:05
+  { P3(ZES, OVER, TWEE)                  },  //  2:06
+  { P3(ZEVEN, OVER, TWEE)                },  //  2:07
+  { P3(ACHT, OVER, TWEE)                 },  //  2:08
+  { P3(NEGEN, OVER, TWEE)                },  //  2:09
+  { P3(TIEN, OVER, TWEE)                 },  //  2:10
+  { P3(ELF, OVER, TWEE)                  },  //  2:11
+  { P3(TWAALF, OVER, TWEE)               },  //  2:12
+  { P3(DERTIEN, OVER, TWEE)              },  //  2:13
+  { P3(VEERTIEN, OVER, TWEE)             },  //  2:14
+  { P3(KWART, OVER, TWEE)                },  //  2:15
+  { P4(VEERTIEN, VOOR, HALF, DRIE)       },  //  2:16
+  { P4(DERTIEN, VOOR, HALF, DRIE)        },  //  2:17
+  { P4(TWAALF, VOOR, HALF, DRIE)         },  //  2:18
+  { P4(ELF, VOOR, HALF, DRIE)            },  //  2:19
+  { P4(TIEN, VOOR, HALF, DRIE)           },  //  2:20
+  { P4(NEGEN, VOOR, HALF, DRIE)          },  //  2:21
+  { P4(ACHT, VOOR, HALF, DRIE)           },  //  2:22
+  { P4(ZEVEN, VOOR, HALF, DRIE)          },  //  2:23
+  { P4(ZES, VOOR, HALF, DRIE)            },  //  2:24
+  { P4(VIJF, VOOR, HALF, DRIE)           },  //  2:25
+  { P4(VIER, VOOR, HALF, DRIE)           },  //  2:26
+  { P4(DRIE, VOOR, HALF, DRIE)           },  //  2:27
+  { P4(TWEE, VOOR, HALF, DRIE)           },  //  2:28
+  { P4(EEN, VOOR, HALF, DRIE)            },  //  2:29
+  { P2(HALF, DRIE)                       },  //  2:30
+  { P4(EEN, OVER, HALF, DRIE)            },  //  2:31
+  { P4(TWEE, OVER, HALF, DRIE)           },  //  2:32
+  { P4(DRIE, OVER, HALF, DRIE)           },  //  2:33
+  { P4(VIER, OVER, HALF, DRIE)           },  //  2:34
+  { P4(VIJF, OVER, HALF, DRIE)           },  //  2:35
+  { P4(ZES, OVER, HALF, DRIE)            },  //  2:36
+  { P4(ZEVEN, OVER, HALF, DRIE)          },  //  2:37
+  { P4(ACHT, OVER, HALF, DRIE)           },  //  2:38
+  { P4(NEGEN, OVER, HALF, DRIE)          },  //  2:39
+  { P4(TIEN, OVER, HALF, DRIE)           },  //  2:40
+  { P4(ELF, OVER, HALF, DRIE)            },  //  2:41
+  { P4(TWAALF, OVER, HALF, DRIE)         },  //  2:42
+  { P4(DERTIEN, OVER, HALF, DRIE)        },  //  2:43
+  { P4(VEERTIEN, OVER, HALF, DRIE)       },  //  2:44
+  { P3(KWART, VOOR, DRIE)                },  //  2:45
+  { P3(VEERTIEN, VOOR, DRIE)             },  //  2:46
+  { P3(DERTIEN, VOOR, DRIE)              },  //  2:47
+  { P3(TWAALF, VOOR, DRIE)               },  //  2:48
+  { P3(ELF, VOOR, DRIE)                  },  //  2:49
+  { P3(TIEN, VOOR, DRIE)                 },  //  2:50
+  { P3(NEGEN, VOOR, DRIE)                },  //  2:51
+  { P3(ACHT, VOOR, DRIE)                 },  //  2:52
+  { P3(ZEVEN, VOOR, DRIE)                },  //  2:53
+  { P3(ZES, VOOR, DRIE)                  },  //  2:54
+  { P3(VIJF, VOOR, DRIE)                 },  //  2:55
+  { P3(VIER, VOOR, DRIE)                 },  //  2:56
+  { P3(DRIE, VOOR, DRIE)                 },  //  2:57
+  { P3(TWEE, VOOR, DRIE)                 },  //  2:58
+  { P3(EEN, VOOR, DRIE)                  },  //  2:59
+  { P2(DRIE, UUR)                        },  //  3:00
+  { P3(EEN, OVER, DRIE)                  },  //  3:01
+  { P3(TWEE, OVER, DRIE)                 },  //  3:02
+  { P3(DRIE, OVER, DRIE)                 },  //  3:03
+  { P3(VIER, OVER, DRIE)                 },  //  3:04
+  { P3(VIJF, OVER, DRIE)                 },  //  3:05
+  { P3(ZES, OVER, DRIE)                  },  //  3:06
+  { P3(ZEVEN, OVER, DRIE)                },  //  3:07
+  { P3(ACHT, OVER, DRIE)                 },  //  3:08
+  { P3(NEGEN, OVER, DRIE)                },  //  3:09
+  { P3(TIEN, OVER, DRIE)                 },  //  3:10
+  { P3(ELF, OVER, DRIE)                  },  //  3:11
+  { P3(TWAALF, OVER, DRIE)               },  //  3:12
+  { P3(DERTIEN, OVER, DRIE)              },  //  3:13
+  { P3(VEERTIEN, OVER, DRIE)             },  //  3:14
+  { P3(KWART, OVER, DRIE)                },  //  3:15
+  { P4(VEERTIEN, VOOR, HALF, VIER)       },  //  3:16
+  { P4(DERTIEN, VOOR, HALF, VIER)        },  //  3:17
+  { P4(TWAALF, VOOR, HALF, VIER)         },  //  3:18
+  { P4(ELF, VOOR, HALF, VIER)            },  //  3:19
+  { P4(TIEN, VOOR, HALF, VIER)           },  //  3:20
+  { P4(NEGEN, VOOR, HALF, VIER)          },  //  3:21
+  { P4(ACHT, VOOR, HALF, VIER)           },  //  3:22
+  { P4(ZEVEN, VOOR, HALF, VIER)          },  //  3:23
+  { P4(ZES, VOOR, HALF, VIER)            },  //  3:24
+  { P4(VIJF, VOOR, HALF, VIER)           },  //  3:25
+  { P4(VIER, VOOR, HALF, VIER)           },  //  3:26
+  { P4(DRIE, VOOR, HALF, VIER)           },  //  3:27
+  { P4(TWEE, VOOR, HALF, VIER)           },  //  3:28
+  { P4(EEN, VOOR, HALF, VIER)            },  //  3:29
+  { P2(HALF, VIER)                       },  //  3:30
+  { P4(EEN, OVER, HALF, VIER)            },  //  3:31
+  { P4(TWEE, OVER, HALF, VIER)           },  //  3:32
+  { P4(DRIE, OVER, HALF, VIER)           },  //  3:33
+  { P4(VIER, OVER, HALF, VIER)           },  //  3:34
+  { P4(VIJF, OVER, HALF, VIER)           },  //  3:35
+  { P4(ZES, OVER, HALF, VIER)            },  //  3:36
+  { P4(ZEVEN, OVER, HALF, VIER)          },  //  3:37
+  { P4(ACHT, OVER, HALF, VIER)           },  //  3:38
+  { P4(NEGEN, OVER, HALF, VIER)          },  //  3:39
+  { P4(TIEN, OVER, HALF, VIER)           },  //  3:40
+  { P4(ELF, OVER, HALF, VIER)            },  //  3:41
+  { P4(TWAALF, OVER, HALF, VIER)         },  //  3:42
+  { P4(DERTIEN, OVER, HALF, VIER)        },  //  3:43
+  { P4(VEERTIEN, OVER, HALF, VIER)       },  //  3:44
+  { P3(KWART, VOOR, VIER)                },  //  3:45
+  { P3(VEERTIEN, VOOR, VIER)             },  //  3:46
+  { P3(DERTIEN, VOOR, VIER)              },  //  3:47
+  { P3(TWAALF, VOOR, VIER)               },  //  3:48
+  { P3(ELF, VOOR, VIER)                  },  //  3:49
+  { P3(TIEN, VOOR, VIER)                 },  //  3:50
+  { P3(NEGEN, VOOR, VIER)                },  //  3:51
+  { P3(ACHT, VOOR, VIER)                 },  //  3:52
+  { P3(ZEVEN, VOOR, VIER)                },  //  3:53
+  { P3(ZES, VOOR, VIER)                  },  //  3:54
+  { P3(VIJF, VOOR, VIER)                 },  //  3:55
+  { P3(VIER, VOOR, VIER)                 },  //  3:56
+  { P3(DRIE, VOOR, VIER)                 },  //  3:57
+  { P3(TWEE, VOOR, VIER)                 },  //  3:58
+  { P3(EEN, VOOR, VIER)                  },  //  3:59
+  { P2(VIER, UUR)                        },  //  4:00
+  { P3(EEN, OVER, VIER)                  },  //  4:01
+  { P3(TWEE, OVER, VIER)                 },  //  4:02
+  { P3(DRIE, OVER, VIER)                 },  //  4:03
+  { P3(VIER, OVER, VIER)                 },  //  4:04
+  { P3(VIJF, OVER, VIER)                 },  //  4:05
+  { P3(ZES, OVER, VIER)                  },  //  4:06
+  { P3(ZEVEN, OVER, VIER)                },  //  4:07
+  { P3(ACHT, OVER, VIER)                 },  //  4:08
+  { P3(NEGEN, OVER, VIER)                },  //  4:09
+  { P3(TIEN, OVER, VIER)                 },  //  4:10
+  { P3(ELF, OVER, VIER)                  },  //  4:11
+  { P3(TWAALF, OVER, VIER)               },  //  4:12
+  { P3(DERTIEN, OVER, VIER)              },  //  4:13
+  { P3(VEERTIEN, OVER, VIER)             },  //  4:14
+  { P3(KWART, OVER, VIER)                },  //  4:15
+  { P4(VEERTIEN, VOOR, HALF, VIJF)       },  //  4:16
+  { P4(DERTIEN, VOOR, HALF, VIJF)        },  //  4:17
+  { P4(TWAALF, VOOR, HALF, VIJF)         },  //  4:18
+  { P4(ELF, VOOR, HALF, VIJF)            },  //  4:19
+  { P4(TIEN, VOOR, HALF, VIJF)           },  //  4:20
+  { P4(NEGEN, VOOR, HALF, VIJF)          },  //  4:21
+  { P4(ACHT, VOOR, HALF, VIJF)           },  //  4:22
+  { P4(ZEVEN, VOOR, HALF, VIJF)          },  //  4:23
+  { P4(ZES, VOOR, HALF, VIJF)            },  //  4:24
+  { P4(VIJF, VOOR, HALF, VIJF)           },  //  4:25
+  { P4(VIER, VOOR, HALF, VIJF)           },  //  4:26
+  { P4(DRIE, VOOR, HALF, VIJF)           },  //  4:27
+  { P4(TWEE, VOOR, HALF, VIJF)           },  //  4:28
+  { P4(EEN, VOOR, HALF, VIJF)            },  //  4:29
+  { P2(HALF, VIJF)                       },  //  4:30
+  { P4(EEN, OVER, HALF, VIJF)            },  //  4:31
+  { P4(TWEE, OVER, HALF, VIJF)           },  //  4:32
+  { P4(DRIE, OVER, HALF, VIJF)           },  //  4:33
+  { P4(VIER, OVER, HALF, VIJF)           },  //  4:34
+  { P4(VIJF, OVER, HALF, VIJF)           },  //  4:35
+  { P4(ZES, OVER, HALF, VIJF)            },  //  4:36
+  { P4(ZEVEN, OVER, HALF, VIJF)          },  //  4:37
+  { P4(ACHT, OVER, HALF, VIJF)           },  //  4:38
+  { P4(NEGEN, OVER, HALF, VIJF)          },  //  4:39
+  { P4(TIEN, OVER, HALF, VIJF)           },  //  4:40
+  { P4(ELF, OVER, HALF, VIJF)            },  //  4:41
+  { P4(TWAALF, OVER, HALF, VIJF)         },  //  4:42
+  { P4(DERTIEN, OVER, HALF, VIJF)        },  //  4:43
+  { P4(VEERTIEN, OVER, HALF, VIJF)       },  //  4:44
+  { P3(KWART, VOOR, VIJF)                },  //  4:45
+  { P3(VEERTIEN, VOOR, VIJF)             },  //  4:46
+  { P3(DERTIEN, VOOR, VIJF)              },  //  4:47
+  { P3(TWAALF, VOOR, VIJF)               },  //  4:48
+  { P3(ELF, VOOR, VIJF)                  },  //  4:49
+  { P3(TIEN, VOOR, VIJF)                 },  //  4:50
+  { P3(NEGEN, VOOR, VIJF)                },  //  4:51
+  { P3(ACHT, VOOR, VIJF)                 },  //  4:52
+  { P3(ZEVEN, VOOR, VIJF)                },  //  4:53
+  { P3(ZES, VOOR, VIJF)                  },  //  4:54
+  { P3(VIJF, VOOR, VIJF)                 },  //  4:55
+  { P3(VIER, VOOR, VIJF)                 },  //  4:56
+  { P3(DRIE, VOOR, VIJF)                 },  //  4:57
+  { P3(TWEE, VOOR, VIJF)                 },  //  4:58
+  { P3(EEN, VOOR, VIJF)                  },  //  4:59
+  { P2(VIJF, UUR)                        },  //  5:00
+  { P3(EEN, OVER, VIJF)                  },  //  5:01
+  { P3(TWEE, OVER, VIJF)                 },  //  5:02
+  { P3(DRIE, OVER, VIJF)                 },  //  5:03
+  { P3(VIER, OVER, VIJF)                 },  //  5:04
+  { P3(VIJF, OVER, VIJF)                 },  //  5:05
+  { P3(ZES, OVER, VIJF)                  },  //  5:06
+  { P3(ZEVEN, OVER, VIJF)                },  //  5:07
+  { P3(ACHT, OVER, VIJF)                 },  //  5:08
+  { P3(NEGEN, OVER, VIJF)                },  //  5:09
+  { P3(TIEN, OVER, VIJF)                 },  //  5:10
+  { P3(ELF, OVER, VIJF)                  },  //  5:11
+  { P3(TWAALF, OVER, VIJF)               },  //  5:12
+  { P3(DERTIEN, OVER, VIJF)              },  //  5:13
+  { P3(VEERTIEN, OVER, VIJF)             },  //  5:14
+  { P3(KWART, OVER, VIJF)                },  //  5:15
+  { P4(VEERTIEN, VOOR, HALF, ZES)        },  //  5:16
+  { P4(DERTIEN, VOOR, HALF, ZES)         },  //  5:17
+  { P4(TWAALF, VOOR, HALF, ZES)          },  //  5:18
+  { P4(ELF, VOOR, HALF, ZES)             },  //  5:19
+  { P4(TIEN, VOOR, HALF, ZES)            },  //  5:20
+  { P4(NEGEN, VOOR, HALF, ZES)           },  //  5:21
+  { P4(ACHT, VOOR, HALF, ZES)            },  //  5:22
+  { P4(ZEVEN, VOOR, HALF, ZES)           },  //  5:23
+  { P4(ZES, VOOR, HALF, ZES)             },  //  5:24
+  { P4(VIJF, VOOR, HALF, ZES)            },  //  5:25
+  { P4(VIER, VOOR, HALF, ZES)            },  //  5:26
+  { P4(DRIE, VOOR, HALF, ZES)            },  //  5:27
+  { P4(TWEE, VOOR, HALF, ZES)            },  //  5:28
+  { P4(EEN, VOOR, HALF, ZES)             },  //  5:29
+  { P2(HALF, ZES)                        },  //  5:30
+  { P4(EEN, OVER, HALF, ZES)             },  //  5:31
+  { P4(TWEE, OVER, HALF, ZES)            },  //  5:32
+  { P4(DRIE, OVER, HALF, ZES)            },  //  5:33
+  { P4(VIER, OVER, HALF, ZES)            },  //  5:34
+  { P4(VIJF, OVER, HALF, ZES)            },  //  5:35
+  { P4(ZES, OVER, HALF, ZES)             },  //  5:36
+  { P4(ZEVEN, OVER, HALF, ZES)           },  //  5:37
+  { P4(ACHT, OVER, HALF, ZES)            },  //  5:38
+  { P4(NEGEN, OVER, HALF, ZES)           },  //  5:39
+  { P4(TIEN, OVER, HALF, ZES)            },  //  5:40
+  { P4(ELF, OVER, HALF, ZES)             },  //  5:41
+  { P4(TWAALF, OVER, HALF, ZES)          },  //  5:42
+  { P4(DERTIEN, OVER, HALF, ZES)         },  //  5:43
+  { P4(VEERTIEN, OVER, HALF, ZES)        },  //  5:44
+  { P3(KWART, VOOR, ZES)                 },  //  5:45
+  { P3(VEERTIEN, VOOR, ZES)              },  //  5:46
+  { P3(DERTIEN, VOOR, ZES)               },  //  5:47
+  { P3(TWAALF, VOOR, ZES)                },  //  5:48
+  { P3(ELF, VOOR, ZES)                   },  //  5:49
+  { P3(TIEN, VOOR, ZES)                  },  //  5:50
+  { P3(NEGEN, VOOR, ZES)                 },  //  5:51
+  { P3(ACHT, VOOR, ZES)                  },  //  5:52
+  { P3(ZEVEN, VOOR, ZES)                 },  //  5:53
+  { P3(ZES, VOOR, ZES)                   },  //  5:54
+  { P3(VIJF, VOOR, ZES)                  },  //  5:55
+  { P3(VIER, VOOR, ZES)                  },  //  5:56
+  { P3(DRIE, VOOR, ZES)                  },  //  5:57
+  { P3(TWEE, VOOR, ZES)                  },  //  5:58
+  { P3(EEN, VOOR, ZES)                   },  //  5:59
+  { P2(ZES, UUR)                         },  //  6:00
+  { P3(EEN, OVER, ZES)                   },  //  6:01
+  { P3(TWEE, OVER, ZES)                  },  //  6:02
+  { P3(DRIE, OVER, ZES)                  },  //  6:03
+  { P3(VIER, OVER, ZES)                  },  //  6:04
+  { P3(VIJF, OVER, ZES)                  },  //  6:05
+  { P3(ZES, OVER, ZES)                   },  //  6:06
+  { P3(ZEVEN, OVER, ZES)                 },  //  6:07
+  { P3(ACHT, OVER, ZES)                  },  //  6:08
+  { P3(NEGEN, OVER, ZES)                 },  //  6:09
+  { P3(TIEN, OVER, ZES)                  },  //  6:10
+  { P3(ELF, OVER, ZES)                   },  //  6:11
+  { P3(TWAALF, OVER, ZES)                },  //  6:12
+  { P3(DERTIEN, OVER, ZES)               },  //  6:13
+  { P3(VEERTIEN, OVER, ZES)              },  //  6:14
+  { P3(KWART, OVER, ZES)                 },  //  6:15
+  { P4(VEERTIEN, VOOR, HALF, ZEVEN)      },  //  6:16
+  { P4(DERTIEN, VOOR, HALF, ZEVEN)       },  //  6:17
+  { P4(TWAALF, VOOR, HALF, ZEVEN)        },  //  6:18
+  { P4(ELF, VOOR, HALF, ZEVEN)           },  //  6:19
+  { P4(TIEN, VOOR, HALF, ZEVEN)          },  //  6:20
+  { P4(NEGEN, VOOR, HALF, ZEVEN)         },  //  6:21
+  { P4(ACHT, VOOR, HALF, ZEVEN)          },  //  6:22
+  { P4(ZEVEN, VOOR, HALF, ZEVEN)         },  //  6:23
+  { P4(ZES, VOOR, HALF, ZEVEN)           },  //  6:24
+  { P4(VIJF, VOOR, HALF, ZEVEN)          },  //  6:25
+  { P4(VIER, VOOR, HALF, ZEVEN)          },  //  6:26
+  { P4(DRIE, VOOR, HALF, ZEVEN)          },  //  6:27
+  { P4(TWEE, VOOR, HALF, ZEVEN)          },  //  6:28
+  { P4(EEN, VOOR, HALF, ZEVEN)           },  //  6:29
+  { P2(HALF, ZEVEN)                      },  //  6:30
+  { P4(EEN, OVER, HALF, ZEVEN)           },  //  6:31
+  { P4(TWEE, OVER, HALF, ZEVEN)          },  //  6:32
+  { P4(DRIE, OVER, HALF, ZEVEN)          },  //  6:33
+  { P4(VIER, OVER, HALF, ZEVEN)          },  //  6:34
+  { P4(VIJF, OVER, HALF, ZEVEN)          },  //  6:35
+  { P4(ZES, OVER, HALF, ZEVEN)           },  //  6:36
+  { P4(ZEVEN, OVER, HALF, ZEVEN)         },  //  6:37
+  { P4(ACHT, OVER, HALF, ZEVEN)          },  //  6:38
+  { P4(NEGEN, OVER, HALF, ZEVEN)         },  //  6:39
+  { P4(TIEN, OVER, HALF, ZEVEN)          },  //  6:40
+  { P4(ELF, OVER, HALF, ZEVEN)           },  //  6:41
+  { P4(TWAALF, OVER, HALF, ZEVEN)        },  //  6:42
+  { P4(DERTIEN, OVER, HALF, ZEVEN)       },  //  6:43
+  { P4(VEERTIEN, OVER, HALF, ZEVEN)      },  //  6:44
+  { P3(KWART, VOOR, ZEVEN)               },  //  6:45
+  { P3(VEERTIEN, VOOR, ZEVEN)            },  //  6:46
+  { P3(DERTIEN, VOOR, ZEVEN)             },  //  6:47
+  { P3(TWAALF, VOOR, ZEVEN)              },  //  6:48
+  { P3(ELF, VOOR, ZEVEN)                 },  //  6:49
+  { P3(TIEN, VOOR, ZEVEN)                },  //  6:50
+  { P3(NEGEN, VOOR, ZEVEN)               },  //  6:51
+  { P3(ACHT, VOOR, ZEVEN)                },  //  6:52
+  { P3(ZEVEN, VOOR, ZEVEN)               },  //  6:53
+  { P3(ZES, VOOR, ZEVEN)                 },  //  6:54
+  { P3(VIJF, VOOR, ZEVEN)                },  //  6:55
+  { P3(VIER, VOOR, ZEVEN)                },  //  6:56
+  { P3(DRIE, VOOR, ZEVEN)                },  //  6:57
+  { P3(TWEE, VOOR, ZEVEN)                },  //  6:58
+  { P3(EEN, VOOR, ZEVEN)                 },  //  6:59
+  { P2(ZEVEN, UUR)                       },  //  7:00
+  { P3(EEN, OVER, ZEVEN)                 },  //  7:01
+  { P3(TWEE, OVER, ZEVEN)                },  //  7:02
+  { P3(DRIE, OVER, ZEVEN)                },  //  7:03
+  { P3(VIER, OVER, ZEVEN)                },  //  7:04
+  { P3(VIJF, OVER, ZEVEN)                },  //  7:05
+  { P3(ZES, OVER, ZEVEN)                 },  //  7:06
+  { P3(ZEVEN, OVER, ZEVEN)               },  //  7:07
+  { P3(ACHT, OVER, ZEVEN)                },  //  7:08
+  { P3(NEGEN, OVER, ZEVEN)               },  //  7:09
+  { P3(TIEN, OVER, ZEVEN)                },  //  7:10
+  { P3(ELF, OVER, ZEVEN)                 },  //  7:11
+  { P3(TWAALF, OVER, ZEVEN)              },  //  7:12
+  { P3(DERTIEN, OVER, ZEVEN)             },  //  7:13
+  { P3(VEERTIEN, OVER, ZEVEN)            },  //  7:14
+  { P3(KWART, OVER, ZEVEN)               },  //  7:15
+  { P4(VEERTIEN, VOOR, HALF, ACHT)       },  //  7:16
+  { P4(DERTIEN, VOOR, HALF, ACHT)        },  //  7:17
+  { P4(TWAALF, VOOR, HALF, ACHT)         },  //  7:18
+  { P4(ELF, VOOR, HALF, ACHT)            },  //  7:19
+  { P4(TIEN, VOOR, HALF, ACHT)           },  //  7:20
+  { P4(NEGEN, VOOR, HALF, ACHT)          },  //  7:21
+  { P4(ACHT, VOOR, HALF, ACHT)           },  //  7:22
+  { P4(ZEVEN, VOOR, HALF, ACHT)          },  //  7:23
+  { P4(ZES, VOOR, HALF, ACHT)            },  //  7:24
+  { P4(VIJF, VOOR, HALF, ACHT)           },  //  7:25
+  { P4(VIER, VOOR, HALF, ACHT)           },  //  7:26
+  { P4(DRIE, VOOR, HALF, ACHT)           },  //  7:27
+  { P4(TWEE, VOOR, HALF, ACHT)           },  //  7:28
+  { P4(EEN, VOOR, HALF, ACHT)            },  //  7:29
+  { P2(HALF, ACHT)                       },  //  7:30
+  { P4(EEN, OVER, HALF, ACHT)            },  //  7:31
+  { P4(TWEE, OVER, HALF, ACHT)           },  //  7:32
+  { P4(DRIE, OVER, HALF, ACHT)           },  //  7:33
+  { P4(VIER, OVER, HALF, ACHT)           },  //  7:34
+  { P4(VIJF, OVER, HALF, ACHT)           },  //  7:35
+  { P4(ZES, OVER, HALF, ACHT)            },  //  7:36
+  { P4(ZEVEN, OVER, HALF, ACHT)          },  //  7:37
+  { P4(ACHT, OVER, HALF, ACHT)           },  //  7:38
+  { P4(NEGEN, OVER, HALF, ACHT)          },  //  7:39
+  { P4(TIEN, OVER, HALF, ACHT)           },  //  7:40
+  { P4(ELF, OVER, HALF, ACHT)            },  //  7:41
+  { P4(TWAALF, OVER, HALF, ACHT)         },  //  7:42
+  { P4(DERTIEN, OVER, HALF, ACHT)        },  //  7:43
+  { P4(VEERTIEN, OVER, HALF, ACHT)       },  //  7:44
+  { P3(KWART, VOOR, ACHT)                },  //  7:45
+  { P3(VEERTIEN, VOOR, ACHT)             },  //  7:46
+  { P3(DERTIEN, VOOR, ACHT)              },  //  7:47
+  { P3(TWAALF, VOOR, ACHT)               },  //  7:48
+  { P3(ELF, VOOR, ACHT)                  },  //  7:49
+  { P3(TIEN, VOOR, ACHT)                 },  //  7:50
+  { P3(NEGEN, VOOR, ACHT)                },  //  7:51
+  { P3(ACHT, VOOR, ACHT)                 },  //  7:52
+  { P3(ZEVEN, VOOR, ACHT)                },  //  7:53
+  { P3(ZES, VOOR, ACHT)                  },  //  7:54
+  { P3(VIJF, VOOR, ACHT)                 },  //  7:55
+  { P3(VIER, VOOR, ACHT)                 },  //  7:56
+  { P3(DRIE, VOOR, ACHT)                 },  //  7:57
+  { P3(TWEE, VOOR, ACHT)                 },  //  7:58
+  { P3(EEN, VOOR, ACHT)                  },  //  7:59
+  { P2(ACHT, UUR)                        },  //  8:00
+  { P3(EEN, OVER, ACHT)                  },  //  8:01
+  { P3(TWEE, OVER, ACHT)                 },  //  8:02
+  { P3(DRIE, OVER, ACHT)                 },  //  8:03
+  { P3(VIER, OVER, ACHT)                 },  //  8:04
+  { P3(VIJF, OVER, ACHT)                 },  //  8:05
+  { P3(ZES, OVER, ACHT)                  },  //  8:06
+  { P3(ZEVEN, OVER, ACHT)                },  //  8:07
+  { P3(ACHT, OVER, ACHT)                 },  //  8:08
+  { P3(NEGEN, OVER, ACHT)                },  //  8:09
+  { P3(TIEN, OVER, ACHT)                 },  //  8:10
+  { P3(ELF, OVER, ACHT)                  },  //  8:11
+  { P3(TWAALF, OVER, ACHT)               },  //  8:12
+  { P3(DERTIEN, OVER, ACHT)              },  //  8:13
+  { P3(VEERTIEN, OVER, ACHT)             },  //  8:14
+  { P3(KWART, OVER, ACHT)                },  //  8:15
+  { P4(VEERTIEN, VOOR, HALF, NEGEN)      },  //  8:16
+  { P4(DERTIEN, VOOR, HALF, NEGEN)       },  //  8:17
+  { P4(TWAALF, VOOR, HALF, NEGEN)        },  //  8:18
+  { P4(ELF, VOOR, HALF, NEGEN)           },  //  8:19
+  { P4(TIEN, VOOR, HALF, NEGEN)          },  //  8:20
+  { P4(NEGEN, VOOR, HALF, NEGEN)         },  //  8:21
+  { P4(ACHT, VOOR, HALF, NEGEN)          },  //  8:22
+  { P4(ZEVEN, VOOR, HALF, NEGEN)         },  //  8:23
+  { P4(ZES, VOOR, HALF, NEGEN)           },  //  8:24
+  { P4(VIJF, VOOR, HALF, NEGEN)          },  //  8:25
+  { P4(VIER, VOOR, HALF, NEGEN)          },  //  8:26
+  { P4(DRIE, VOOR, HALF, NEGEN)          },  //  8:27
+  { P4(TWEE, VOOR, HALF, NEGEN)          },  //  8:28
+  { P4(EEN, VOOR, HALF, NEGEN)           },  //  8:29
+  { P2(HALF, NEGEN)                      },  //  8:30
+  { P4(EEN, OVER, HALF, NEGEN)           },  //  8:31
+  { P4(TWEE, OVER, HALF, NEGEN)          },  //  8:32
+  { P4(DRIE, OVER, HALF, NEGEN)          },  //  8:33
+  { P4(VIER, OVER, HALF, NEGEN)          },  //  8:34
+  { P4(VIJF, OVER, HALF, NEGEN)          },  //  8:35
+  { P4(ZES, OVER, HALF, NEGEN)           },  //  8:36
+  { P4(ZEVEN, OVER, HALF, NEGEN)         },  //  8:37
+  { P4(ACHT, OVER, HALF, NEGEN)          },  //  8:38
+  { P4(NEGEN, OVER, HALF, NEGEN)         },  //  8:39
+  { P4(TIEN, OVER, HALF, NEGEN)          },  //  8:40
+  { P4(ELF, OVER, HALF, NEGEN)           },  //  8:41
+  { P4(TWAALF, OVER, HALF, NEGEN)        },  //  8:42
+  { P4(DERTIEN, OVER, HALF, NEGEN)       },  //  8:43
+  { P4(VEERTIEN, OVER, HALF, NEGEN)      },  //  8:44
+  { P3(KWART, VOOR, NEGEN)               },  //  8:45
+  { P3(VEERTIEN, VOOR, NEGEN)            },  //  8:46
+  { P3(DERTIEN, VOOR, NEGEN)             },  //  8:47
+  { P3(TWAALF, VOOR, NEGEN)              },  //  8:48
+  { P3(ELF, VOOR, NEGEN)                 },  //  8:49
+  { P3(TIEN, VOOR, NEGEN)                },  //  8:50
+  { P3(NEGEN, VOOR, NEGEN)               },  //  8:51
+  { P3(ACHT, VOOR, NEGEN)                },  //  8:52
+  { P3(ZEVEN, VOOR, NEGEN)               },  //  8:53
+  { P3(ZES, VOOR, NEGEN)                 },  //  8:54
+  { P3(VIJF, VOOR, NEGEN)                },  //  8:55
+  { P3(VIER, VOOR, NEGEN)                },  //  8:56
+  { P3(DRIE, VOOR, NEGEN)                },  //  8:57
+  { P3(TWEE, VOOR, NEGEN)                },  //  8:58
+  { P3(EEN, VOOR, NEGEN)                 },  //  8:59
+  { P2(NEGEN, UUR)                       },  //  9:00
+  { P3(EEN, OVER, NEGEN)                 },  //  9:01
+  { P3(TWEE, OVER, NEGEN)                },  //  9:02
+  { P3(DRIE, OVER, NEGEN)                },  //  9:03
+  { P3(VIER, OVER, NEGEN)                },  //  9:04
+  { P3(VIJF, OVER, NEGEN)                },  //  9:05
+  { P3(ZES, OVER, NEGEN)                 },  //  9:06
+  { P3(ZEVEN, OVER, NEGEN)               },  //  9:07
+  { P3(ACHT, OVER, NEGEN)                },  //  9:08
+  { P3(NEGEN, OVER, NEGEN)               },  //  9:09
+  { P3(TIEN, OVER, NEGEN)                },  //  9:10
+  { P3(ELF, OVER, NEGEN)                 },  //  9:11
+  { P3(TWAALF, OVER, NEGEN)              },  //  9:12
+  { P3(DERTIEN, OVER, NEGEN)             },  //  9:13
+  { P3(VEERTIEN, OVER, NEGEN)            },  //  9:14
+  { P3(KWART, OVER, NEGEN)               },  //  9:15
+  { P4(VEERTIEN, VOOR, HALF, TIEN)       },  //  9:16
+  { P4(DERTIEN, VOOR, HALF, TIEN)        },  //  9:17
+  { P4(TWAALF, VOOR, HALF, TIEN)         },  //  9:18
+  { P4(ELF, VOOR, HALF, TIEN)            },  //  9:19
+  { P4(TIEN, VOOR, HALF, TIEN)           },  //  9:20
+  { P4(NEGEN, VOOR, HALF, TIEN)          },  //  9:21
+  { P4(ACHT, VOOR, HALF, TIEN)           },  //  9:22
+  { P4(ZEVEN, VOOR, HALF, TIEN)          },  //  9:23
+  { P4(ZES, VOOR, HALF, TIEN)            },  //  9:24
+  { P4(VIJF, VOOR, HALF, TIEN)           },  //  9:25
+  { P4(VIER, VOOR, HALF, TIEN)           },  //  9:26
+  { P4(DRIE, VOOR, HALF, TIEN)           },  //  9:27
+  { P4(TWEE, VOOR, HALF, TIEN)           },  //  9:28
+  { P4(EEN, VOOR, HALF, TIEN)            },  //  9:29
+  { P2(HALF, TIEN)                       },  //  9:30
+  { P4(EEN, OVER, HALF, TIEN)            },  //  9:31
+  { P4(TWEE, OVER, HALF, TIEN)           },  //  9:32
+  { P4(DRIE, OVER, HALF, TIEN)           },  //  9:33
+  { P4(VIER, OVER, HALF, TIEN)           },  //  9:34
+  { P4(VIJF, OVER, HALF, TIEN)           },  //  9:35
+  { P4(ZES, OVER, HALF, TIEN)            },  //  9:36
+  { P4(ZEVEN, OVER, HALF, TIEN)          },  //  9:37
+  { P4(ACHT, OVER, HALF, TIEN)           },  //  9:38
+  { P4(NEGEN, OVER, HALF, TIEN)          },  //  9:39
+  { P4(TIEN, OVER, HALF, TIEN)           },  //  9:40
+  { P4(ELF, OVER, HALF, TIEN)            },  //  9:41
+  { P4(TWAALF, OVER, HALF, TIEN)         },  //  9:42
+  { P4(DERTIEN, OVER, HALF, TIEN)        },  //  9:43
+  { P4(VEERTIEN, OVER, HALF, TIEN)       },  //  9:44
+  { P3(KWART, VOOR, TIEN)                },  //  9:45
+  { P3(VEERTIEN, VOOR, TIEN)             },  //  9:46
+  { P3(DERTIEN, VOOR, TIEN)              },  //  9:47
+  { P3(TWAALF, VOOR, TIEN)               },  //  9:48
+  { P3(ELF, VOOR, TIEN)                  },  //  9:49
+  { P3(TIEN, VOOR, TIEN)                 },  //  9:50
+  { P3(NEGEN, VOOR, TIEN)                },  //  9:51
+  { P3(ACHT, VOOR, TIEN)                 },  //  9:52
+  { P3(ZEVEN, VOOR, TIEN)                },  //  9:53
+  { P3(ZES, VOOR, TIEN)                  },  //  9:54
+  { P3(VIJF, VOOR, TIEN)                 },  //  9:55
+  { P3(VIER, VOOR, TIEN)                 },  //  9:56
+  { P3(DRIE, VOOR, TIEN)                 },  //  9:57
+  { P3(TWEE, VOOR, TIEN)                 },  //  9:58
+  { P3(EEN, VOOR, TIEN)                  },  //  9:59
+  { P2(TIEN, UUR)                        },  // 10:00
+  { P3(EEN, OVER, TIEN)                  },  // 10:01
+  { P3(TWEE, OVER, TIEN)                 },  // 10:02
+  { P3(DRIE, OVER, TIEN)                 },  // 10:03
+  { P3(VIER, OVER, TIEN)                 },  // 10:04
+  { P3(VIJF, OVER, TIEN)                 },  // 10:05
+  { P3(ZES, OVER, TIEN)                  },  // 10:06
+  { P3(ZEVEN, OVER, TIEN)                },  // 10:07
+  { P3(ACHT, OVER, TIEN)                 },  // 10:08
+  { P3(NEGEN, OVER, TIEN)                },  // 10:09
+  { P3(TIEN, OVER, TIEN)                 },  // 10:10
+  { P3(ELF, OVER, TIEN)                  },  // 10:11
+  { P3(TWAALF, OVER, TIEN)               },  // 10:12
+  { P3(DERTIEN, OVER, TIEN)              },  // 10:13
+  { P3(VEERTIEN, OVER, TIEN)             },  // 10:14
+  { P3(KWART, OVER, TIEN)                },  // 10:15
+  { P4(VEERTIEN, VOOR, HALF, ELF)        },  // 10:16
+  { P4(DERTIEN, VOOR, HALF, ELF)         },  // 10:17
+  { P4(TWAALF, VOOR, HALF, ELF)          },  // 10:18
+  { P4(ELF, VOOR, HALF, ELF)             },  // 10:19
+  { P4(TIEN, VOOR, HALF, ELF)            },  // 10:20
+  { P4(NEGEN, VOOR, HALF, ELF)           },  // 10:21
+  { P4(ACHT, VOOR, HALF, ELF)            },  // 10:22
+  { P4(ZEVEN, VOOR, HALF, ELF)           },  // 10:23
+  { P4(ZES, VOOR, HALF, ELF)             },  // 10:24
+  { P4(VIJF, VOOR, HALF, ELF)            },  // 10:25
+  { P4(VIER, VOOR, HALF, ELF)            },  // 10:26
+  { P4(DRIE, VOOR, HALF, ELF)            },  // 10:27
+  { P4(TWEE, VOOR, HALF, ELF)            },  // 10:28
+  { P4(EEN, VOOR, HALF, ELF)             },  // 10:29
+  { P2(HALF, ELF)                        },  // 10:30
+  { P4(EEN, OVER, HALF, ELF)             },  // 10:31
+  { P4(TWEE, OVER, HALF, ELF)            },  // 10:32
+  { P4(DRIE, OVER, HALF, ELF)            },  // 10:33
+  { P4(VIER, OVER, HALF, ELF)            },  // 10:34
+  { P4(VIJF, OVER, HALF, ELF)            },  // 10:35
+  { P4(ZES, OVER, HALF, ELF)             },  // 10:36
+  { P4(ZEVEN, OVER, HALF, ELF)           },  // 10:37
+  { P4(ACHT, OVER, HALF, ELF)            },  // 10:38
+  { P4(NEGEN, OVER, HALF, ELF)           },  // 10:39
+  { P4(TIEN, OVER, HALF, ELF)            },  // 10:40
+  { P4(ELF, OVER, HALF, ELF)             },  // 10:41
+  { P4(TWAALF, OVER, HALF, ELF)          },  // 10:42
+  { P4(DERTIEN, OVER, HALF, ELF)         },  // 10:43
+  { P4(VEERTIEN, OVER, HALF, ELF)        },  // 10:44
+  { P3(KWART, VOOR, ELF)                 },  // 10:45
+  { P3(VEERTIEN, VOOR, ELF)              },  // 10:46
+  { P3(DERTIEN, VOOR, ELF)               },  // 10:47
+  { P3(TWAALF, VOOR, ELF)                },  // 10:48
+  { P3(ELF, VOOR, ELF)                   },  // 10:49
+  { P3(TIEN, VOOR, ELF)                  },  // 10:50
+  { P3(NEGEN, VOOR, ELF)                 },  // 10:51
+  { P3(ACHT, VOOR, ELF)                  },  // 10:52
+  { P3(ZEVEN, VOOR, ELF)                 },  // 10:53
+  { P3(ZES, VOOR, ELF)                   },  // 10:54
+  { P3(VIJF, VOOR, ELF)                  },  // 10:55
+  { P3(VIER, VOOR, ELF)                  },  // 10:56
+  { P3(DRIE, VOOR, ELF)                  },  // 10:57
+  { P3(TWEE, VOOR, ELF)                  },  // 10:58
+  { P3(EEN, VOOR, ELF)                   },  // 10:59
+  { P2(ELF, UUR)                         },  // 11:00
+  { P3(EEN, OVER, ELF)                   },  // 11:01
+  { P3(TWEE, OVER, ELF)                  },  // 11:02
+  { P3(DRIE, OVER, ELF)                  },  // 11:03
+  { P3(VIER, OVER, ELF)                  },  // 11:04
+  { P3(VIJF, OVER, ELF)                  },  // 11:05
+  { P3(ZES, OVER, ELF)                   },  // 11:06
+  { P3(ZEVEN, OVER, ELF)                 },  // 11:07
+  { P3(ACHT, OVER, ELF)                  },  // 11:08
+  { P3(NEGEN, OVER, ELF)                 },  // 11:09
+  { P3(TIEN, OVER, ELF)                  },  // 11:10
+  { P3(ELF, OVER, ELF)                   },  // 11:11
+  { P3(TWAALF, OVER, ELF)                },  // 11:12
+  { P3(DERTIEN, OVER, ELF)               },  // 11:13
+  { P3(VEERTIEN, OVER, ELF)              },  // 11:14
+  { P3(KWART, OVER, ELF)                 },  // 11:15
+  { P4(VEERTIEN, VOOR, HALF, TWAALF)     },  // 11:16
+  { P4(DERTIEN, VOOR, HALF, TWAALF)      },  // 11:17
+  { P4(TWAALF, VOOR, HALF, TWAALF)       },  // 11:18
+  { P4(ELF, VOOR, HALF, TWAALF)          },  // 11:19
+  { P4(TIEN, VOOR, HALF, TWAALF)         },  // 11:20
+  { P4(NEGEN, VOOR, HALF, TWAALF)        },  // 11:21
+  { P4(ACHT, VOOR, HALF, TWAALF)         },  // 11:22
+  { P4(ZEVEN, VOOR, HALF, TWAALF)        },  // 11:23
+  { P4(ZES, VOOR, HALF, TWAALF)          },  // 11:24
+  { P4(VIJF, VOOR, HALF, TWAALF)         },  // 11:25
+  { P4(VIER, VOOR, HALF, TWAALF)         },  // 11:26
+  { P4(DRIE, VOOR, HALF, TWAALF)         },  // 11:27
+  { P4(TWEE, VOOR, HALF, TWAALF)         },  // 11:28
+  { P4(EEN, VOOR, HALF, TWAALF)          },  // 11:29
+  { P2(HALF, TWAALF)                     },  // 11:30
+  { P4(EEN, OVER, HALF, TWAALF)          },  // 11:31
+  { P4(TWEE, OVER, HALF, TWAALF)         },  // 11:32
+  { P4(DRIE, OVER, HALF, TWAALF)         },  // 11:33
+  { P4(VIER, OVER, HALF, TWAALF)         },  // 11:34
+  { P4(VIJF, OVER, HALF, TWAALF)         },  // 11:35
+  { P4(ZES, OVER, HALF, TWAALF)          },  // 11:36
+  { P4(ZEVEN, OVER, HALF, TWAALF)        },  // 11:37
+  { P4(ACHT, OVER, HALF, TWAALF)         },  // 11:38
+  { P4(NEGEN, OVER, HALF, TWAALF)        },  // 11:39
+  { P4(TIEN, OVER, HALF, TWAALF)         },  // 11:40
+  { P4(ELF, OVER, HALF, TWAALF)          },  // 11:41
+  { P4(TWAALF, OVER, HALF, TWAALF)       },  // 11:42
+  { P4(DERTIEN, OVER, HALF, TWAALF)      },  // 11:43
+  { P4(VEERTIEN, OVER, HALF, TWAALF)     },  // 11:44
+  { P3(KWART, VOOR, TWAALF)              },  // 11:45
+  { P3(VEERTIEN, VOOR, TWAALF)           },  // 11:46
+  { P3(DERTIEN, VOOR, TWAALF)            },  // 11:47
+  { P3(TWAALF, VOOR, TWAALF)             },  // 11:48
+  { P3(ELF, VOOR, TWAALF)                },  // 11:49
+  { P3(TIEN, VOOR, TWAALF)               },  // 11:50
+  { P3(NEGEN, VOOR, TWAALF)              },  // 11:51
+  { P3(ACHT, VOOR, TWAALF)               },  // 11:52
+  { P3(ZEVEN, VOOR, TWAALF)              },  // 11:53
+  { P3(ZES, VOOR, TWAALF)                },  // 11:54
+  { P3(VIJF, VOOR, TWAALF)               },  // 11:55
+  { P3(VIER, VOOR, TWAALF)               },  // 11:56
+  { P3(DRIE, VOOR, TWAALF)               },  // 11:57
+  { P3(TWEE, VOOR, TWAALF)               },  // 11:58
+  { P3(EEN, VOOR, TWAALF)                }   // 11:59
+};
+
+#undef P4
+#undef P3
+#undef P2
@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+#
+# Generates phrases.h; the spoken sentence for every time on the dial
+#
+#   python3 phrases.py > phrases.h
+#
+# The sentences follow the way the clock has always said the time (Dutch, 12 hours): every sentence starts with
+# "het is nu", which isn't stored. The rest is at most four words, 5 bits each, packed into 3 bytes.
+#
+
+WORDS = ['', 'EEN', 'TWEE', 'DRIE', 'VIER', 'VIJF', 'ZES', 'ZEVEN', 'ACHT', 'NEGEN', 'TIEN', 'ELF', 'TWAALF',
+         'DERTIEN', 'VEERTIEN', 'HALF', 'KWART', 'HET_IS_NU', 'OVER', 'VOOR', 'UUR']
+
+EEN, HALF, KWART, OVER, VOOR, UUR = 1, 15, 16, 18, 19, 20
+
+
+def sentence(hour, minute):
+    afterhour  = 12 if hour == 0 else hour
+    beforehour = 1 if hour % 12 == 0 else hour + 1
+
+    if minute % 15 == 0:
+        return [[afterhour, UUR],
+                [KWART, OVER, afterhour],
+                [HALF, beforehour],
+                [KWART, VOOR, beforehour]][minute // 15]
+
+    return [[minute, OVER, afterhour],
+            [30 - minute, VOOR, HALF, beforehour],
+            [minute - 30, OVER, HALF, beforehour],
+            [60 - minute, VOOR, beforehour]][minute // 15]
+
+
+print("""/*
+ * Phrases  (Generated by phrases.py; don't edit)
+ *
+ * The words to say after "het is nu" for every time on the dial: phrases[hour12 * 60 + minute].
+ * An entry is packed by P2() .. P4(): up to four word numbers (speech.h) of PHRASEWORDBITS each, the first in the
+ * lowest bits; 0 ends the phrase.
+ *
+ * The table lives in flash (PROGMEM); read it through pgm_read_byte().
+ *
+ */
+
+#define PHRASES             720  // 12 hours of 60 minutes
+#define PHRASEBYTES           3
+#define PHRASEWORDBITS        5
+#define PHRASEWORDMASK     0x1F
+
+#define P4(a, b, c, d)  (uint8_t)( (a) | (b) << 5 ), \\
+                        (uint8_t)( (b) >> 3 | (c) << 2 | (d) << 7 ), \\
+                        (uint8_t)( (d) >> 1 )
+#define P3(a, b, c)     P4(a, b, c, 0)
+#define P2(a, b)        P4(a, b, 0, 0)
+
+const uint8_t phrases[PHRASES][PHRASEBYTES] PROGMEM = {""")
+
+for hour in range(12):
+    for minute in range(60):
+        words = sentence(hour, minute)
+        assert len(words) <= 4 and all(0 < w < 32 for w in words)
+        last  = hour == 11 and minute == 59
+        entry = 'P%d(%s)' % (len(words), ', '.join(WORDS[w] for w in words))
+        print('  { %-36s }%s  // %2d:%02d' % (entry, ' ' if last else ',', hour, minute))
+
+print("""};
+
+#undef P4
+#undef P3
+#undef P2""")
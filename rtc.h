@@ -5,31 +5,88 @@
  * - Syncing the PC time to the RTC clock
  * - Syncing the Time from the RTC to the internal clock
  * - Running dynamically from the internal clock i.o. the RTC for "power saving"
- * - Managing DST (Western Europe switch programmed) - even when the clock will be turned off for a few years (Writing DST state to Arduino Nano EEPROM)
+ * - Measuring how far the internal clock drifts from the RTC and correcting it (ppm), so it only needs the RTC now and then
+ * - Optionally taking the seconds from the 1 Hz square wave of the RTC (TICKSOURCE) through an interrupt
+ * - Keeping the time going from the internal clock while the RTC is away and reconnecting to it in the background
+ * - Managing DST (rules per time zone in tz.h) - even when the clock will be turned off for a few years (Storing the DST state in the battery backed RAM of the RTC; see persist.h)
  * 
  *  
  * Functions
  *    init_RTC()              -- Initialize the RTC
- *    AssumeDST()             -- Determine based on the RTC's date whether we're in DST or not and correcting if EEPROM has a different DST value
+ *    AssumeDST()             -- Determine based on the RTC's date whether we're in DST or not and correcting if the stored DST value differs
  *    DST_Fix()               -- Checking the current date and time and determine if the moment has come to change DST status
+ *    loadTimeZone()          -- Select the time zone rules; the one stored in EEPROM or else the build time TIMEZONE
+ *    cacheDST()              -- Determine the DST switch moments of a year; done at boot and when the year rolls over
+ *    ruleSwitch()            -- Determine the moment of one time zone rule in a year
+ *    inDST()                 -- Checking a winter time timestamp against the cached DST switch moments
  *    DayOfTheWeek()          -- Determine the day of the week (mo/tu/we/th/fr/sa/su) ; necessary for DST determination
  *    
  *    setRTCTime()            -- Set the RTC Time to the PC system time
- *    reset_RTC()             -- Resetting the connection to the RTC; used when this connection is broken or the RTC has crashed
- *    check_RTC_Status()      -- Checking whether the RTC is still running and store this state
- *    check_RTC_OK()          -- Returning the RTC running state
- *    Sync_ITC()              -- Sync the RTC to the ITC (Internal Clock)
+ *    rtcFault()              -- Noting that the RTC doesn't answer or doesn't run; starts the recovery
+ *    recoverRTC()            -- One step of the recovery; restarting the connection to the RTC with a backoff
+ *    check_RTC_Status()      -- Checking whether the RTC is still running; a fault when it isn't
+ *    check_RTC_OK()          -- Returning whether the RTC is running and connected
+ *    Sync_ITC()              -- Sync the RTC to the ITC (Internal Clock); straight away, to the whole second
+ *    requestSync()           -- Probe the RTC; start measuring the ITC against it when the sync interval has passed
+ *    pollSync()              -- Looking for the start of an RTC second; syncs the ITC to it and updates the drift
+ *    rtcSecond()             -- Reading just the seconds register of the RTC
+ *    startSQW() / stopSQW()  -- Switching the 1 Hz square wave of the RTC and its interrupt on / off (TICK_SQW)
+ *    syncSQW()               -- Checking the count of SQW ticks against the RTC right after a tick (TICK_SQW)
  *    
- *    TimeChanged()           -- Check whether the time has changed from five seconds until the hours
+ *    TimeChanged()           -- Check whether the time has changed from five seconds until the hours (for the clock's leds)
  *    elapsed()               -- Determine whether the amount of milliseconds is allready elapsed
  *    SetNewPreviousTime()    -- Storing the last time that has been shown
- *    getTime()               -- Retrieving the time from the internal time clock
+ *    getTime()               -- Retrieving the time from the internal time clock; only does work once per second
+ *    countITC()              -- Counting the seconds with millis() and the drift correction
+ *    countSQW()              -- Taking the seconds over from the SQW interrupt (TICK_SQW)
+ *    advanceTick()           -- Moving the snapshot on to a unixtime
+ *    setTick()               -- Taking a new snapshot of the time from a unixtime
+ *    setSecond()             -- Moving the snapshot to another second within the same minute
+ *    idle()                  -- Letting the CPU sleep until the next interrupt (TICK_SQW)
  *    
- *    Second()                -- Getting the current Seconds value  (max 60)
- *    FiveSecond()            -- Determine the FiveSecond value     (max 12)
- *    Minute()                -- Getting the current Minute value   (max 60)
- *    FiveMinute()            -- Determine the FiveMinute value     (max 12)
- *    Hour()                  -- Gettting the current Hour value    (max 12)
+ *  The time is read from a snapshot (Current.tick) that getTime() takes once per second; all fields are plain
+ *  values so reading them costs nothing. When only the seconds advanced the snapshot is updated in place
+ *  instead of redoing the date math.
+ *    tick.epoch              -- Unixtime of the snapshot (local time)
+ *    tick.hour / hour12      -- Hours (0..23) / hours on the dial (0..11)
+ *    tick.minute             -- Minutes
+ *    tick.fiveMinute         -- Minutes rounded down to five (0..55)
+ *    tick.second             -- Seconds
+ *    tick.fiveSecond         -- Seconds rounded down to five (0..55)
+ *    tick.evenSecond         -- Whether the second is even
+ *    tick.minuteLed          -- The led of the minutes (0..11); the hour led is hour12
+ *    tick.secondLed          -- The led of the seconds (0..11)
+ *    
+ *  Time events (added to the Schedule in scheduler.h by the sketch):
+ *    CheckDST()              -- Switch DST when the moment has come; every hour
+ *    SyncTime()              -- Check the RTC is there and sync the ITC with it when the sync interval has passed;
+ *                               every quarter
+ *    
+ *  Drift calibration:
+ *    The resonator of the Nano can be off by thousands of ppm (seconds per quarter). Every sync catches the start
+ *    of an RTC second (polling the seconds register from just before the ITC's own next second) and measures how
+ *    far the ITC is off. That offset over the time since the previous sync is the remaining drift in ppm; it is
+ *    added to the correction applied to every ITC second and stored (see persist.h). The sync interval doubles
+ *    while the offset stays within half of SYNCMAXERROR and halves when it exceeds it.
+ *    
+ *  Tick source:
+ *    TICK_MILLIS             -- The seconds are counted with millis() and the drift correction (default)
+ *    TICK_SQW                -- The SQW/OUT pin of the DS1307 runs a 1 Hz square wave into SQWPIN; every falling
+ *                               edge (where the RTC's second starts) advances a counter in an interrupt and flags
+ *                               a tick. The start of a second is known to the millisecond without polling, so the
+ *                               CPU can sleep between interrupts. A sync only checks the count against the RTC.
+ *                               When the ticks stop coming (SQW/OUT not wired) the seconds are counted with
+ *                               millis() again.
+ *    
+ *  RTC faults:
+ *    When the RTC doesn't answer on the I2C bus or has stopped, the clock keeps running from the ITC (with the
+ *    time it had, or the build time when the RTC was away from the start) and the quarters turn red (see clock.h).
+ *    The recovery runs one short step per loop pass: wait, restart the I2C bus and the RTC, probe it. A failed
+ *    probe doubles the wait (RECOVERMINDELAY up to RECOVERMAXDELAY). When the RTC answers but has stopped (its
+ *    battery ran out) it is started again with the time of the ITC. After that the ITC is synced to the next RTC
+ *    second and the DST state checked like at boot; when the RTC was away from the start the stored state (see
+ *    persist.h) is read first, so the drift and the DST state are applied and new records follow the stored ones.
+ *    rtcFaults, i2cErrors, rtcRecoveries and recoveryMillis(Max) count what happened.
  *    
  */
 
@@ -37,34 +94,120 @@
 // Arduino -> RTC
 // A4      -> SDA (Default for Nano)
 // A5      -> SCL (Default for Nano)
+// D3      -> SQW/OUT (Only with TICK_SQW)
+
+#define EEPROM_TZ                 1  // The time zone EEPROM address; an invalid value selects TIMEZONE
+
+#define SYNCMAXERROR             50  // Milliseconds the ITC may be off from the RTC
+#define SYNCMININTERVAL          15  // Minutes between syncs; shortest
+#define SYNCMAXINTERVAL         960  // Minutes between syncs; longest (doublings of SYNCMININTERVAL)
+#define SYNCWINDOW              100  // Milliseconds before the ITC's next second to start looking for the RTC's
+#define SYNCPOLL                  2  // Milliseconds between reads of the RTC seconds while looking
+#define SYNCTIMEOUT            2000  // Milliseconds to look before syncing the hard way
+#define SYNCMAXSTEP            5000  // Milliseconds off beyond which the RTC has been set; no drift measured
+
+#define DRIFTMAX              10000  // ppm; a larger correction is a measuring error
+#define DRIFTSTORESTEP            2  // ppm the correction changes before it is stored again
+
+#define TICK_MILLIS               0
+#define TICK_SQW                  1
+
+#define TICKSOURCE      TICK_MILLIS  // Where the seconds come from; see above
+#define SQWPIN                    3  // INT1; SQW/OUT is open drain, so the internal pull up is used
+#define SQWTIMEOUT             1500  // Milliseconds without a tick before counting with millis() again
 
-#define EEPROM_DST                0  // The DST EEPROM address; storing the last DST state here
+#define RTC_RUNNING               0  // Recovery states
+#define RTC_BACKOFF               1  // Waiting before the next attempt
+#define RTC_RESTART               2  // Restarting the I2C bus and the RTC
+#define RTC_PROBE                 3  // Checking whether the RTC answers and runs
+
+#define RECOVERMINDELAY        1000  // Milliseconds before the first attempt to reconnect
+#define RECOVERMAXDELAY       64000  // Milliseconds between attempts; longest
 
 #include <Wire.h>
 #include "RTClib.h"
 #include <EEPROM.h>
+#include "./tz.h"
+#include "./persist.h"
+
+#if TICKSOURCE == TICK_SQW
+#include <avr/sleep.h>
+
+// Shared with the SQW interrupt
+volatile uint32_t      sqwEpoch;    // Advanced by every tick
+volatile unsigned long sqwMillis;   // millis() at the last tick
+volatile bool          sqwTicked = false;
+
+void sqwTick() {
+  sqwEpoch++;
+  sqwMillis = millis();
+  sqwTicked = true;
+}
+#endif
+
+// One second of time with everything that is derived from it
+struct TimeTick {
+  uint32_t epoch;
+  uint16_t year;
+  uint8_t  hour;
+  uint8_t  hour12;
+  uint8_t  minute;
+  uint8_t  fiveMinute;
+  uint8_t  second;
+  uint8_t  fiveSecond;
+  bool     evenSecond;
+  uint8_t  minuteLed;
+  uint8_t  secondLed;
+};
 
 class Time
 {
   private:
     RTC_DS1307    RTC;    // The actual RTC module (RealTime Clock)
-    RTC_Millis    ITC;    // The internal arduino "counter"
-    DateTime      now;
+    TimeTick      now;                // The snapshot; the ITC (internal clock) counts on from here with millis()
+    unsigned long tickMillis;         // millis() at the start of the snapshot's second
+
+    int16_t       drift         = 0;  // ppm the millis() run fast; every ITC second is this many us longer
+    int16_t       driftFraction = 0;  // us of drift correction not applied yet
+
+    bool          syncing       = false;
+    bool          syncWaiting;        // Waiting for the ITC's next second to come near
+    bool          syncValid     = false;  // Whether the ITC was synced to the start of an RTC second
+    uint8_t       syncSecond;         // The RTC seconds register when looking started
+    unsigned long syncStart, syncPoll;
+    unsigned long syncMillis;         // millis() at the last sync
+    uint16_t      syncInterval  = SYNCMININTERVAL;
+
+    bool          sqwActive     = false;  // Whether the seconds come from the SQW interrupt
     
-    byte          previous_hour, previous_fiveminute, previous_minute, previous_fivesecond, previous_second;
-    bool          RTC_Status = false; // True when RTC is running & connected
+    uint32_t      previous_epoch;
+    byte          previous_hour, previous_fiveminute, previous_fivesecond;
+    uint8_t       rtcState      = RTC_RUNNING;
+    unsigned long faultMillis;        // millis() when the fault was noticed
+    unsigned long retryMillis;        // millis() when the backoff started
+    unsigned long retryDelay;
+    bool          timeKnown     = false;  // Whether the ITC ever got the time from the RTC
+
+    TimeZone      zone;               // The DST rules in use (copied from tz.h)
+
+    // DST switch moments of dstYear as unixtime in winter time; the RTC runs on the local (wall clock) time
+    uint16_t      dstYear    = 0;
+    uint32_t      dstStart;
+    uint32_t      dstEnd;
+    uint16_t      dstShift;           // Seconds the clock moves forward in summer
   
   public:
     unsigned long lastTimeChange;
-    
-    bool          evenSecond                      = false;
-    bool          unevenSecond                    = not(evenSecond);
-    
-    bool          ExecuteMinuteChangePattern      = false;
-    bool          ExecuteFiveMinuteChangePattern  = false;
-    bool          ExecuteHourChangePattern        = false;
-    bool          ExecuteQuarterChangePattern     = false;
 
+    const TimeTick &tick                          = now;   // The current second; read only
+    const int16_t  &driftPpm                      = drift; // The drift correction in use; read only
+
+    unsigned long rtcFaults          = 0;  // Times the RTC went away
+    unsigned long i2cErrors          = 0;  // Failed attempts to reach a running RTC
+    unsigned long rtcRecoveries      = 0;
+    unsigned long recoveryMillis     = 0;  // How long the last fault lasted
+    unsigned long recoveryMillisMax  = 0;
+    
     bool          DST                             = false;
   
   Time()
@@ -75,12 +218,11 @@ class Time
   
   void init_RTC() {
       Serial.println(F("Initializing RTC..."));
+      Persisted.init();
+      drift = constrain(Persisted.drift(), -DRIFTMAX, DRIFTMAX);
       
       if (! RTC.isrunning()) {
         RTC.adjust(DateTime(__DATE__, __TIME__));
-        RTC_Status = false;
-      } else {
-        RTC_Status = true;
       }
             
 //    Testing DST functions
@@ -88,87 +230,145 @@ class Time
 //      RTC.adjust(DateTime (2017, 10, 29, 2, 59, 30));     // Test switching to wintertime
 //      RTC.adjust(DateTime (2017, 10, 29, 12, 14, 55));    // Test switching quarter
 
+#if TICKSOURCE == TICK_SQW
+      startSQW();
+#endif
       Sync_ITC();
 
+      if ( not check_RTC_OK() ) {
+        // No time to start from; the recovery syncs it when the RTC shows up
+        setTick(DateTime(__DATE__, __TIME__).unixtime());
+        tickMillis = millis();
+        Schedule.reschedule(now.epoch);   // Else the events of this minute would all run at once
+      }
+
       SetNewPreviousTime();
-      AssumeDST();
+      loadTimeZone();
+      if ( check_RTC_OK() ) {
+        AssumeDST();                  // Else after the recovery
+      }
    }
   
 
   void AssumeDST() {
-    uint8_t DSTSwitchDay;
-    
     // Function that is run on initialization that will "Assume" the current DST state based on the date
-    // Note that this is only valid if both RTC and Arduino keep running together
+    // The stored DST state tells whether the RTC's time includes DST; that gives the winter time to check against
+    uint8_t  stored   = Persisted.dst();
+    uint32_t local    = now.epoch;
 
-    if ( ( now.month() >= 4 ) && ( now.month() <= 10 ) ) {
-      DST = true;   // Summer time
-    } else {
-      DST = false;  // Winter time
-    }
-    
-    // Check if we are in March or October
-    if ( ( now.month() == 3 ) || ( now.month() == 10 ) ) {
-        for ( DSTSwitchDay = 25; DSTSwitchDay < 32; DSTSwitchDay++ ) {
-              // Function stops whenever day 0 (sunday) is found, shouldn't take too long
-              if ( DayOfTheWeek(now.year(), now.month(), DSTSwitchDay) == 0 ) { break; }
-        }
+    cacheDST(now.year);
 
-        Serial.print("Switching DST this month on day ");
-        Serial.println(DSTSwitchDay);
-        
-        // Check if we should switch; if so SWITCH
-        if ( now.day() > DSTSwitchDay ) { DST = not(DST); }
-        // This goes wrong if the clock is restarted on the day of DST after the DST has actually changed (TOO BAD I need some debugging space too!)
+    if ( stored > 1 ) {
+      // Nothing stored yet; the RTC was set from the PC's local time
+      stored = inDST(local);
     }
 
+    uint32_t winter   = local - ( stored ? dstShift : 0 );
+    DST               = inDST(winter);
+
     if ( DST == true ) {
       Serial.println(F("We are in summer time now!"));
     } else {
       Serial.println(F("We are in winter time now!"));
     }
 
-    if  ( EEPROM.read(EEPROM_DST) != DST ) {
+    if  ( stored != DST ) {
       if ( DST == true ) {
         Serial.println(F("Stored DST setting was Winter Time; adjusting RTC to match Summer time now!"));
-        RTC.adjust(DateTime (now.year(), now.month(), now.day(), now.hour() + 1, now.minute(), now.second()));
       } else {
         Serial.println(F("Stored DST setting was Summer Time; adjusting RTC to match Winter time now!"));
-        RTC.adjust(DateTime (now.year(), now.month(), now.day(), now.hour() - 1, now.minute(), now.second()));
       }
+      RTC.adjust(DateTime(winter + ( DST ? dstShift : 0 )));
+      Sync_ITC();
 
       // Correcting the currently stored DST state
-      EEPROM.write(EEPROM_DST, DST);
+      Persisted.setDST(DST);
+      Schedule.dstChanged();
     } else {
-      Serial.println(F("EEPROM agrees with the current time; no adjustment needed"));
+      Serial.println(F("Stored DST state agrees with the current time; no adjustment needed"));
     }
   }
 
   void DST_Fix() {
-    // Source: http://www.instructables.com/id/The-Arduino-and-Daylight-Saving-Time-Europe/
-    if (DayOfTheWeek(now.year(), now.month(), now.day()) == 0 && now.month() == 10 && now.day() >= 25 && now.hour() == 3 && DST==true)  // Switch to winter time in October
-    {
-      //      setclockto 2 am; // 1 hour back
-      Serial.println(F("Adjusting time to match Winter time now"));
-      RTC.adjust(DateTime (now.year(), now.month(), now.day(), now.hour() - 1, now.minute(), now.second()));
-      DST=false;
-      getTime();
-      SetNewPreviousTime();
-    } 
-  
-    if (DayOfTheWeek(now.year(), now.month(), now.day()) == 0 && now.month() == 3 && now.day() >= 25 && now.hour() == 2 && DST==false) // Switch to summer time in March
-    {
-      //      setclockto 3 am; // 1 hour forward
-      Serial.println(F("Adjusting time to match Summer time now"));
-      RTC.adjust(DateTime (now.year(), now.month(), now.day(), now.hour() + 1, now.minute(), now.second()));
-      DST=true;
-      getTime();
+    uint32_t local = now.epoch;
+
+    if ( not check_RTC_OK() ) {
+      return;                         // The stored state belongs to the RTC's time; the recovery checks it
+    }
+
+    if ( now.year != dstYear ) {
+      cacheDST(now.year);
+    }
+
+    // Compare the winter time against the cached switch moments
+    bool summer = inDST(local - ( DST ? dstShift : 0 ));
+
+    if ( summer != DST ) {
+      if ( summer ) {
+        Serial.println(F("Adjusting time to match Summer time now"));
+        RTC.adjust(DateTime(local + dstShift));
+      } else {
+        Serial.println(F("Adjusting time to match Winter time now"));
+        RTC.adjust(DateTime(local - dstShift));
+      }
+      Sync_ITC();
+      if ( not check_RTC_OK() ) {
+        return;                       // Went away while switching; the recovery makes the switch
+      }
+      DST = summer;
       SetNewPreviousTime();
-    } 
+      Schedule.dstChanged();
+    }
+
+    // Store the current DST status; only written when it changed
+    Persisted.setDST(DST);
+  }
+
+  void loadTimeZone() {
+    uint8_t stored = EEPROM.read(EEPROM_TZ);
+
+    if ( stored >= TZ_ZONES ) {
+      stored = TIMEZONE;
+    }
+    memcpy_P(&zone, &timeZones[stored], sizeof(zone));
+    dstShift = zone.shift * 60;
+    dstYear  = 0;                     // Recache on the next check
+
+    Serial.print(F("Time zone "));
+    Serial.println(stored);
+  }
+
+  void cacheDST(uint16_t year) {
+    dstYear  = year;
+    dstStart = 0;
+    dstEnd   = 0;                                        // Never summer time
 
-    // Write the current DST status
-    Serial.println(F("Writing the DST state to the EEPROM"));
-    EEPROM.write(EEPROM_DST, DST);
+    if ( zone.start.month != 0 ) {
+      dstStart = ruleSwitch(zone.start, year);
+      dstEnd   = ruleSwitch(zone.end, year) - dstShift;  // The end hour is given in summer time
+    }
+  }
+
+  // Source: http://www.instructables.com/id/The-Arduino-and-Daylight-Saving-Time-Europe/ (generalized)
+  uint32_t ruleSwitch(const TZRule &rule, uint16_t year) {
+    static const uint8_t monthDays[] PROGMEM = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    uint8_t days = pgm_read_byte(&monthDays[rule.month - 1]);
+    if ( rule.month == 2 && year % 4 == 0 ) { days++; }   // 2000 - 2099 is all the RTC can hold
+
+    // The first matching day of the week, then whole weeks on; TZ_LAST falls back into the month
+    uint8_t day = 1 + ( 7 + rule.day - DayOfTheWeek(year, rule.month, 1) ) % 7 + ( rule.week - 1 ) * 7;
+    if ( day > days ) { day -= 7; }
+
+    return DateTime(year, rule.month, day, rule.hour, 0, 0).unixtime();
+  }
+
+  bool inDST(uint32_t winter) {
+    if ( dstStart <= dstEnd ) {
+      return ( winter >= dstStart && winter < dstEnd );
+    }
+    // Southern hemisphere; summer time runs over the new year
+    return ( winter >= dstStart || winter < dstEnd );
   }
   
   // Returns day of week for a given date Sunday=0, Saturday=6
@@ -188,67 +388,292 @@ class Time
     check_RTC_Status();
     if ( check_RTC_OK() ) {
       Serial.println(F("RTC is ok; syncing..."));
-      ITC.begin(RTC.now());
+      setTick(RTC.now().unixtime());
+      timeKnown     = true;
+      tickMillis    = millis();
+      driftFraction = 0;
+#if TICKSOURCE == TICK_SQW
+      // Counting on from here; a tick that came in while reading is caught by the check on the next tick
+      noInterrupts();
+      sqwEpoch      = now.epoch;
+      sqwTicked     = false;
+      interrupts();
+#endif
+      Schedule.reschedule(now.epoch);
+
+      // Only synced to the whole second; catch the start of the next RTC second to get in step
+      syncValid   = false;
+      syncing     = true;
+      syncWaiting = true;
     }
-    now = ITC.now();
    }
 
-   void reset_RTC() {
-     Serial.println(F("Resetting wire connection"));
-     Wire.begin();
-     Serial.println(F("Resetting RTC"));
-     RTC.begin();
-     Serial.println(F("Setting ITC time"));
-     Sync_ITC();
-     
-     Serial.println(F("Determining DST"));
-     AssumeDST();
-
-     SetNewPreviousTime();
+   void requestSync() {
+    if ( syncing || not check_RTC_OK() ) {
+      return;
+    }
+    // The syncs can be hours apart; a one byte read every check notices a fault within the quarter
+    check_RTC_Status();
+    if ( not check_RTC_OK() ) {
+      return;
+    }
+    // Checked every SYNCMININTERVAL minutes; a sync halfway a check period counts as a whole one
+    if ( syncValid && ( millis() - syncMillis + SYNCMININTERVAL * 30000UL ) / 60000 < syncInterval ) {
+      return;
+    }
+    syncing     = true;
+    syncWaiting = true;
+   }
+
+   uint8_t rtcSecond() {
+    Wire.beginTransmission(DS1307_ADDRESS);
+    Wire.write((uint8_t)0);
+
+    if ( Wire.endTransmission() != 0 || Wire.requestFrom(DS1307_ADDRESS, 1) != 1 ) {
+      rtcFault();
+      return 0xFF;
+    }
+    return Wire.read();
+   }
+
+   void pollSync() {
+    unsigned long m = millis();
+
+    if ( syncWaiting ) {
+      // The next RTC second should start together with the ITC's
+      if ( (long)( m - tickMillis ) < 1000 - SYNCWINDOW ) {
+        return;
+      }
+      syncWaiting = false;
+      syncSecond  = rtcSecond();
+      if ( not check_RTC_OK() ) {
+        return;
+      }
+      syncStart   = m;
+      syncPoll    = m;
+      return;
+    }
+
+    if ( m - syncPoll < SYNCPOLL ) {
+      return;
+    }
+    syncPoll = m;
+
+    uint8_t second = rtcSecond();
+    if ( not check_RTC_OK() ) {
+      return;
+    }
+
+    if ( second == syncSecond ) {
+      if ( m - syncStart >= SYNCTIMEOUT ) {
+        Serial.println(F("RTC second didn't change"));
+        syncing = false;
+        Sync_ITC();
+      }
+      return;
+    }
+
+    // The RTC second started since the previous poll
+    unsigned long edge   = m - SYNCPOLL / 2;
+    uint32_t      rtc    = RTC.now().unixtime();
+    int32_t       offset = (int32_t)( now.epoch - rtc ) * 1000 + (int32_t)( edge - tickMillis );
+
+    syncing = false;
+
+    if ( offset > SYNCMAXSTEP || offset < -SYNCMAXSTEP ) {
+      Serial.println(F("RTC has been set"));
+      Sync_ITC();
+      return;
+    }
+
+    if ( syncValid ) {
+      int32_t seconds = ( edge - syncMillis ) / 1000;
+
+      drift = constrain(drift + offset * 1000L / seconds, -DRIFTMAX, DRIFTMAX);
+
+      if ( abs(offset) <= SYNCMAXERROR / 2 && syncInterval < SYNCMAXINTERVAL ) {
+        syncInterval *= 2;
+      } else if ( abs(offset) > SYNCMAXERROR && syncInterval > SYNCMININTERVAL ) {
+        syncInterval /= 2;
+      }
+    }
+
+    setTick(rtc);
+    tickMillis    = edge;
+    driftFraction = 0;
+    syncValid     = true;
+    syncMillis    = edge;
+
+    Serial.print(F("ITC was "));
+    Serial.print(offset);
+    Serial.print(F(" ms off; drift "));
+    Serial.print(drift);
+    Serial.print(F(" ppm; next sync in "));
+    Serial.print(syncInterval);
+    Serial.println(F(" minutes"));
+
+    if ( abs(drift - Persisted.drift()) >= DRIFTSTORESTEP ) {
+      Persisted.setDrift(drift);
+    }
+    Schedule.reschedule(now.epoch);
+   }
+
+#if TICKSOURCE == TICK_SQW
+   void startSQW() {
+    RTC.writeSqwPinMode(DS1307_SquareWave1HZ);
+    pinMode(SQWPIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(SQWPIN), sqwTick, FALLING);
+    sqwActive = true;
+   }
+
+   void stopSQW() {
+    detachInterrupt(digitalPinToInterrupt(SQWPIN));
+    sqwActive = false;
+   }
+
+   // Right after a tick the RTC has just moved on to the second the tick started
+   void syncSQW() {
+    check_RTC_Status();               // The ticks keep coming when only the I2C connection is lost
+    if ( not check_RTC_OK() ) {
+      return;
+    }
+
+    uint32_t rtc = RTC.now().unixtime();
+
+    if ( sqwTicked ) {
+      return;                         // The next tick came in while reading; check on that one
+    }
+    syncing = false;
+
+    int32_t offset = (int32_t)( now.epoch - rtc );
+
+    if ( offset != 0 ) {
+      Serial.print(F("SQW count was "));
+      Serial.print(offset);
+      Serial.println(F(" seconds off"));
+
+      noInterrupts();
+      sqwEpoch -= offset;
+      interrupts();
+      setTick(rtc);
+      Schedule.reschedule(now.epoch);
+    }
+
+    // Nothing drifts; only a missed tick or a changed RTC makes the count differ
+    if ( offset != 0 ) {
+      syncInterval = SYNCMININTERVAL;
+    } else if ( syncValid && syncInterval < SYNCMAXINTERVAL ) {
+      syncInterval *= 2;
+    }
+    syncValid  = true;
+    syncMillis = tickMillis;
+   }
+#endif
+
+   void rtcFault() {
+     if ( rtcState != RTC_RUNNING ) {
+       return;
+     }
+     Serial.println(F("RTC is not responding; running on the internal clock"));
+     rtcFaults++;
+     i2cErrors++;
+
+     rtcState    = RTC_BACKOFF;
+     faultMillis = millis();
+     retryMillis = faultMillis;
+     retryDelay  = RECOVERMINDELAY;
+     syncing     = false;
+   }
+
+   // One step per call, so the loop keeps running (speech, serial, leds) while the RTC is away
+   void recoverRTC() {
+     switch ( rtcState ) {
+       case RTC_BACKOFF:
+         if ( millis() - retryMillis >= retryDelay ) {
+           rtcState = RTC_RESTART;
+         }
+         break;
+
+       case RTC_RESTART:
+         Wire.begin();
+         RTC.begin();
+         rtcState = RTC_PROBE;
+         break;
+
+       case RTC_PROBE:
+         Wire.beginTransmission(DS1307_ADDRESS);
+         if ( Wire.endTransmission() != 0 ) {
+           // Not there yet; try again later
+           i2cErrors++;
+           if ( retryDelay < RECOVERMAXDELAY ) {
+             retryDelay *= 2;
+           }
+           retryMillis = millis();
+           rtcState    = RTC_BACKOFF;
+           break;
+         }
+
+         if ( not timeKnown ) {
+           // Away since boot; the stored state in its RAM wasn't read yet and the ring was never found
+           Persisted.init();
+           drift = constrain(Persisted.drift(), -DRIFTMAX, DRIFTMAX);
+         }
+
+         if ( ! RTC.isrunning() ) {
+           Serial.println(F("RTC had stopped; starting it with the internal clock's time"));
+           RTC.adjust(DateTime(now.epoch + (long)( millis() - tickMillis ) / 1000));
+           syncValid = false;           // Nothing to measure the drift against
+         }
+
+         recoveryMillis = millis() - faultMillis;
+         if ( recoveryMillis > recoveryMillisMax ) {
+           recoveryMillisMax = recoveryMillis;
+         }
+         rtcRecoveries++;
+         rtcState = RTC_RUNNING;
+
+         Serial.print(F("RTC is back after "));
+         Serial.print(recoveryMillis);
+         Serial.println(F(" ms"));
+
+#if TICKSOURCE == TICK_SQW
+         startSQW();                  // The RTC may have lost the square wave setting along with its power
+         Sync_ITC();
+#else
+         if ( timeKnown ) {
+           // The ITC kept the time; catch the next RTC second to get in step again (a jump syncs the hard way)
+           syncing     = true;
+           syncWaiting = true;
+         } else {
+           Sync_ITC();                // Away since boot; the ITC runs on the build time
+         }
+#endif
+         AssumeDST();
+         SetNewPreviousTime();
+         break;
+     }
    }
 
    void check_RTC_Status() {
       if ( ! RTC.isrunning() ) {
         Serial.println(F("RTC Is not running anymore!"));
-        RTC_Status = false;
-      } else {
-        RTC_Status = true;
+        rtcFault();
       }
    }
   
    bool check_RTC_OK() {
-      return RTC_Status;
+      return ( rtcState == RTC_RUNNING );
    }
 
    bool TimeChanged() {
 
-      // Hour changed?
-      if ( Hour() != previous_hour ) {
-        ExecuteHourChangePattern        = true;
-        DST_Fix();                                // Execute this each hour
-      }
-
-      // Five minute changed?
-      if ( FiveMinute() != previous_fiveminute )
-      {
-          switch ( FiveMinute() ) {
-            case 15:
-            case 30:
-            case 45:
-            //case 0: // Don't execute when it's a full hour
-              Sync_ITC();                     // Sync time from RTC
-              ExecuteQuarterChangePattern     = true; 
-            break;
-            default:
-              ExecuteFiveMinuteChangePattern  = true; 
-              ExecuteMinuteChangePattern      = true; // Implicit
-            break;
-          }
-      } else if ( Minute() != previous_minute ) {
-              ExecuteMinuteChangePattern      = true;
+      // Still the same second?
+      if ( now.epoch == previous_epoch ) {
+        return false;
       }
+      previous_epoch = now.epoch;
     
-      if ( Hour() == previous_hour && FiveMinute() == previous_fiveminute && FiveSecond() == previous_fivesecond ) {
+      if ( now.hour12 == previous_hour && now.fiveMinute == previous_fiveminute && now.fiveSecond == previous_fivesecond ) {
         return false;
       } else {
         SetNewPreviousTime();
@@ -257,48 +682,114 @@ class Time
    }
 
    void SetNewPreviousTime() {
-      previous_hour       = Hour();
-      previous_fiveminute = FiveMinute();
-      previous_minute     = Minute();
-      previous_fivesecond = FiveSecond();
-      previous_second     = Second();
+      previous_epoch      = now.epoch;
+      previous_hour       = now.hour12;
+      previous_fiveminute = now.fiveMinute;
+      previous_fivesecond = now.fiveSecond;
 
-      lastTimeChange      = millis();
+      lastTimeChange      = tickMillis;     // The start of the second, not the moment it was noticed
    }
 
    void getTime() {
-      if ( check_RTC_OK() ) {
-        now = ITC.now();
+#if TICKSOURCE == TICK_SQW
+      if ( sqwActive ) {
+        countSQW();
+      } else {
+        countITC();
+      }
+#else
+      countITC();
+#endif
+
+      // The time goes on from the internal clock while the RTC is away
+      if ( not check_RTC_OK() ) {
+        recoverRTC();
+      }
+   }
+
+#if TICKSOURCE == TICK_SQW
+   void countSQW() {
+      if ( sqwTicked ) {
+        // A consistent copy; the interrupt may come in halfway
+        noInterrupts();
+        uint32_t epoch = sqwEpoch;
+        tickMillis     = sqwMillis;
+        sqwTicked      = false;
+        interrupts();
+
+        advanceTick(epoch);
+
+        if ( syncing ) {
+          syncSQW();
+        }
+      } else if ( (long)( millis() - tickMillis ) >= SQWTIMEOUT ) {
+        Serial.println(F("No SQW ticks; counting with millis()"));
+        stopSQW();
+        check_RTC_Status();           // The RTC went away or stopped; or else SQW/OUT isn't wired
       }
    }
+#endif
+
+   void countITC() {
+      uint16_t seconds = 0;
+
+      // An ITC second is 1000 ms corrected for the drift; the part below a millisecond is carried over.
+      // A carried millisecond can put tickMillis just past millis(), hence the signed difference.
+      while ( (long)( millis() - tickMillis ) >= 1000 ) {
+        tickMillis    += 1000;
+        driftFraction += drift;
+        while ( driftFraction >=  1000 ) { tickMillis++; driftFraction -= 1000; }
+        while ( driftFraction <= -1000 ) { tickMillis--; driftFraction += 1000; }
+        seconds++;
+      }
 
-   uint8_t Second() {
-      evenSecond    = ( now.second() % 2 == 0 );
-      unevenSecond  = not(evenSecond);
-      return now.second();
+      if ( seconds > 0 ) {
+        advanceTick(now.epoch + seconds);
+      }
+
+      if ( syncing ) {
+        pollSync();
+      }
    }
 
-   uint8_t FiveSecond() {
-      uint8_t seconds = Second() / 5;
-      return  seconds * 5;
+   void advanceTick(uint32_t epoch) {
+      if ( epoch == now.epoch + 1 && now.second < 59 ) {
+        // Only the seconds advanced
+        now.epoch++;
+        setSecond(now.second + 1);
+      } else if ( epoch != now.epoch ) {
+        setTick(epoch);
+      }
    }
 
-   uint8_t Minute() {
-      //return 30;
-      return now.minute();
+   void setTick(uint32_t epoch) {
+      DateTime t(epoch);
+
+      now.epoch       = epoch;
+      now.year        = t.year();
+      now.hour        = t.hour();
+      now.hour12      = now.hour % 12;
+      now.minute      = t.minute();
+      now.fiveMinute  = now.minute - now.minute % 5;
+      now.minuteLed   = now.minute / 5;
+      setSecond(t.second());
    }
 
-   uint8_t FiveMinute() {
-      uint8_t fivemin = Minute() / 5;
-      return fivemin * 5;
+   void setSecond(uint8_t second) {
+      now.second      = second;
+      now.fiveSecond  = second - second % 5;
+      now.secondLed   = second / 5;
+      now.evenSecond  = ( second % 2 == 0 );
    }
 
-   uint8_t Hour() {
-      uint8_t minus = 0;
-      
-      if ( now.hour() >= 12 ) { minus = 12; }
-      //return 6;
-      return now.hour() - minus;
+   // Sleep until the next interrupt: the SQW tick, a serial port or the 1 ms timer
+   void idle() {
+#if TICKSOURCE == TICK_SQW
+      if ( sqwActive ) {
+        set_sleep_mode(SLEEP_MODE_IDLE);
+        sleep_mode();
+      }
+#endif
    }
 
   bool elapsed(unsigned long starttime, unsigned long elapse_time)
@@ -313,5 +804,16 @@ class Time
 
 Time Current;
 
+/* TIME EVENTS; added to the Schedule by the sketch */
+// DST switches happen on the hour
+void CheckDST() {
+  Current.DST_Fix();
+}
+
+// Keep the internal clock in step with the RTC
+void SyncTime() {
+  Current.requestSync();
+}
+
 
 
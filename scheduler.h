@@ -0,0 +1,148 @@
+/*
+ * Scheduler Library
+ *
+ * Runs functions on wall clock moments, cron like:
+ * - every N minutes     (aligned to midnight; every(15, ...) runs at :00, :15, :30 and :45)
+ *                       (or offset minutes later; every(60, ..., 0, 59) runs a minute before every hour)
+ * - at hh:mm            (every day)
+ * - on a DST change
+ *
+ * The moment the next entry can be due is kept, so update() costs a single comparison until then.
+ * Entries that are due at the same minute run in the order they were added; an entry added as
+ * SCHEDULE_EXCLUSIVE stops the entries after it for that minute (the hour change hides the quarter change).
+ * When the clock is set to another time the owner of the time calls reschedule() so nothing is skipped or
+ * run twice.
+ *
+ *  Functions:
+ *    every()           -- Add an entry running every N minutes
+ *    at()              -- Add an entry running every day at hh:mm
+ *    onDST()           -- Add an entry running when the DST state changes
+ *    update()          -- Run the entries that are due; called from the loop with the current unixtime
+ *    reschedule()      -- Determine the next due moment again after the time has been set
+ *    dstChanged()      -- Have the DST entries run on the next update()
+ *
+ */
+
+#define SCHEDULEENTRIES          10  // Maximum amount of entries
+
+#define SCHEDULE_EVERY            0
+#define SCHEDULE_AT               1
+#define SCHEDULE_DST              2
+
+#define SCHEDULE_EXCLUSIVE        1  // Flag; no later entries run when this one runs
+
+#define MINUTESPERDAY          1440
+
+typedef void (*ScheduleCallback)();
+
+struct ScheduleEntry {
+  uint8_t           type;
+  uint8_t           flags;
+  uint16_t          minutes;           // SCHEDULE_EVERY: the interval; SCHEDULE_AT: the minute of the day
+  uint16_t          offset;            // SCHEDULE_EVERY: minutes after the aligned moment
+  ScheduleCallback  callback;
+};
+
+class Scheduler {
+private:
+  ScheduleEntry   entries[SCHEDULEENTRIES];
+  uint8_t         count       = 0;
+
+  uint32_t        nextDue     = 0;     // Nothing to do before this moment
+  uint32_t        timeDue     = 0;     // The next minute to check the entries for
+  uint32_t        lastRun     = 0;     // The minute the entries were checked for last
+  bool            dstPending  = false;
+
+  void add(uint8_t type, uint16_t minutes, ScheduleCallback callback, uint8_t flags, uint16_t offset = 0) {
+    if ( count >= SCHEDULEENTRIES ) {
+      Serial.println(F("Schedule is full!"));
+      return;
+    }
+    entries[count].type     = type;
+    entries[count].flags    = flags;
+    entries[count].minutes  = minutes;
+    entries[count].offset   = offset;
+    entries[count].callback = callback;
+    count++;
+  }
+
+  bool due(const ScheduleEntry &entry, uint16_t minute) {
+    switch ( entry.type ) {
+      case SCHEDULE_EVERY:  return ( minute % entry.minutes == entry.offset );
+      case SCHEDULE_AT:     return ( minute == entry.minutes );
+    }
+    return false;
+  }
+
+  void runMinute(uint16_t minute) {
+    for ( uint8_t i = 0; i < count; i++ ) {
+      if ( due(entries[i], minute) ) {
+        entries[i].callback();
+
+        if ( entries[i].flags & SCHEDULE_EXCLUSIVE ) { break; }
+      }
+    }
+  }
+
+  void runDST() {
+    for ( uint8_t i = 0; i < count; i++ ) {
+      if ( entries[i].type == SCHEDULE_DST ) {
+        entries[i].callback();
+      }
+    }
+  }
+
+public:
+
+void every(uint16_t minutes, ScheduleCallback callback, uint8_t flags = 0, uint16_t offset = 0) {
+  add(SCHEDULE_EVERY, minutes, callback, flags, offset);
+}
+
+void at(uint8_t hour, uint8_t minute, ScheduleCallback callback, uint8_t flags = 0) {
+  add(SCHEDULE_AT, hour * 60 + minute, callback, flags);
+}
+
+void onDST(ScheduleCallback callback) {
+  add(SCHEDULE_DST, 0, callback, 0);
+}
+
+void update(uint32_t epoch) {
+  if ( epoch < nextDue ) {
+    return;
+  }
+
+  if ( epoch >= timeDue ) {
+    uint32_t minute = epoch - epoch % 60;
+
+    lastRun = minute;
+    reschedule(epoch);                // Before running; an entry that sets the clock reschedules itself
+
+    runMinute(( minute / 60 ) % MINUTESPERDAY);
+  }
+
+  if ( dstPending ) {
+    dstPending = false;
+    runDST();
+  }
+
+  nextDue = timeDue;
+}
+
+void reschedule(uint32_t epoch) {
+  timeDue = epoch - epoch % 60 + 60;
+
+  // Set back a few seconds into a minute that already ran; don't run it again
+  if ( timeDue == lastRun ) {
+    timeDue += 60;
+  }
+  nextDue = dstPending ? 0 : timeDue;
+}
+
+void dstChanged() {
+  dstPending = true;
+  nextDue    = 0;
+}
+
+};
+
+Scheduler Schedule;
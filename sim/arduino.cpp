@@ -0,0 +1,399 @@
+/*
+ * Host simulation - Arduino core and virtual clock
+ *
+ * Implements the virtual clock and event queue behind sim.h, plus the core
+ * Arduino functions, String, Print, the USB Serial port and the sketch's heap.
+ *
+ */
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <sim.h>
+
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <queue>
+#include <vector>
+
+namespace sim {
+
+Stats stats;
+
+struct Event {
+  uint64_t              at;
+  uint64_t              seq;
+  std::function<void()> fn;
+
+  bool operator >(const Event &rhs) const { return at != rhs.at ? at > rhs.at : seq > rhs.seq; }
+};
+
+typedef std::priority_queue<Event, std::vector<Event>, std::greater<Event> > EventQueue;
+
+// Function local statics; the sketch calls millis() from global constructors
+static EventQueue &events() {
+  static EventQueue queue;
+  return queue;
+}
+
+static uint64_t clock_us      = 0;
+static int32_t  mcu_drift     = 0;   // ppm the resonator runs fast
+static uint64_t irq_off_until = 0;
+static uint64_t stolen_us     = 0;
+static uint64_t event_seq     = 0;
+
+uint64_t now_us() {
+  return clock_us;
+}
+
+void advance_us(uint64_t us) {
+  uint64_t target = clock_us + us;
+
+  while ( !events().empty() && events().top().at <= target ) {
+    Event event = events().top();
+    events().pop();
+
+    if ( event.at > clock_us ) { clock_us = event.at; }
+    event.fn();
+
+    // Interrupt handlers that ran during this slice delay the foreground
+    target   += stolen_us;
+    stolen_us = 0;
+  }
+
+  clock_us = target;
+}
+
+void irq_off_us(uint64_t us) {
+  irq_off_until    = clock_us + us;
+  stats.irq_off_us += us;
+  advance_us(us);
+}
+
+bool irq_disabled() {
+  return clock_us < irq_off_until;
+}
+
+void steal_us(uint64_t us) {
+  stolen_us += us;
+}
+
+void mcu_ppm(int32_t ppm) {
+  mcu_drift = ppm;
+}
+
+// The time as counted by the MCU's resonator
+static uint64_t mcu_us() {
+  return clock_us + (int64_t)clock_us * mcu_drift / 1000000;
+}
+
+void at_us(uint64_t when, std::function<void()> event) {
+  events().push(Event{ when, event_seq++, event });
+}
+
+}
+
+/* Time */
+unsigned long millis() {
+  sim::advance_us(1);
+  return (unsigned long)(sim::mcu_us() / 1000);
+}
+
+unsigned long micros() {
+  sim::advance_us(1);
+  return (unsigned long)sim::mcu_us();
+}
+
+void delay(unsigned long ms) {
+  sim::advance_us((uint64_t)ms * 1000 * 1000000 / ( 1000000 + sim::mcu_drift ));
+}
+
+void delayMicroseconds(unsigned int us) {
+  sim::advance_us(us);
+}
+
+/* Sleep; idle mode wakes on any interrupt, at the latest on the timer0 overflow every 1024 us */
+void sleep_mode() {
+  uint64_t now  = sim::now_us();
+  uint64_t wake = ( now / 1024 + 1 ) * 1024;
+
+  if ( !sim::events().empty() && sim::events().top().at < wake ) {
+    wake = sim::events().top().at > now ? sim::events().top().at : now;
+  }
+
+  sim::stats.sleep_us += wake - now;
+  sim::advance_us(wake - now);
+}
+
+/* Pins */
+static uint8_t pin_state[32];
+
+void pinMode(uint8_t, uint8_t) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if ( pin < sizeof(pin_state) ) { pin_state[pin] = val; }
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < sizeof(pin_state) ? pin_state[pin] : LOW;
+}
+
+/* External interrupts; INT0 on D2, INT1 on D3 */
+static struct {
+  void (*isr)();
+  int   mode;
+} pin_interrupt[2];
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(), int mode) {
+  if ( interrupt < 2 ) { pin_interrupt[interrupt].isr = isr; pin_interrupt[interrupt].mode = mode; }
+}
+
+void detachInterrupt(uint8_t interrupt) {
+  if ( interrupt < 2 ) { pin_interrupt[interrupt].isr = 0; }
+}
+
+namespace sim {
+
+void pin_edge(uint8_t pin, int edge) {
+  if ( pin < sizeof(pin_state) ) { pin_state[pin] = ( edge == RISING ) ? HIGH : LOW; }
+
+  int interrupt = digitalPinToInterrupt(pin);
+  if ( interrupt == NOT_AN_INTERRUPT || !pin_interrupt[interrupt].isr ) { return; }
+  if ( pin_interrupt[interrupt].mode != edge && pin_interrupt[interrupt].mode != CHANGE ) { return; }
+
+  stats.pin_interrupts++;
+  steal_us(5);
+  pin_interrupt[interrupt].isr();
+}
+
+}
+
+/* Math; deterministic so simulation runs are reproducible */
+static uint32_t random_state = 1;
+
+static uint32_t next_random() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return random_state;
+}
+
+long random(long howbig) {
+  if ( howbig <= 0 ) { return 0; }
+  return next_random() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if ( howsmall >= howbig ) { return howsmall; }
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if ( seed != 0 ) { random_state = seed; }
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/* Heap of the sketch
+ * The Makefile points malloc() / free() / new / delete of the sketch's object files here (objcopy
+ * --redefine-sym), so every block the sketch takes counts in heap_bytes; the simulation's own allocations
+ * don't. A block keeps its size in front of it. */
+static const size_t HEAP_HEADER = sizeof(std::max_align_t);  // Keeps the block aligned
+
+static void heap_take(size_t size) {
+  sim::stats.heap_bytes += size;
+  if ( sim::stats.heap_bytes > sim::stats.heap_peak ) { sim::stats.heap_peak = sim::stats.heap_bytes; }
+}
+
+extern "C" void *sim_malloc(size_t size) {
+  size_t *block = (size_t *)malloc(HEAP_HEADER + size);
+
+  if ( !block ) { return 0; }
+  *block = size;
+  heap_take(size);
+  return (char *)block + HEAP_HEADER;
+}
+
+extern "C" void sim_free(void *p) {
+  if ( !p ) { return; }
+  size_t *block = (size_t *)( (char *)p - HEAP_HEADER );
+
+  sim::stats.heap_bytes -= *block;
+  free(block);
+}
+
+extern "C" void *sim_calloc(size_t count, size_t size) {
+  void *p = sim_malloc(count * size);
+
+  if ( p ) { memset(p, 0, count * size); }
+  return p;
+}
+
+extern "C" void *sim_realloc(void *p, size_t size) {
+  void *q = sim_malloc(size);
+
+  if ( q && p ) {
+    size_t old = *(size_t *)( (char *)p - HEAP_HEADER );
+    memcpy(q, p, old < size ? old : size);
+    sim_free(p);
+  }
+  return q;
+}
+
+extern "C" void *sim_new(size_t size) {
+  void *p = sim_malloc(size ? size : 1);
+
+  if ( !p ) { throw std::bad_alloc(); }
+  return p;
+}
+
+extern "C" void *sim_new_array(size_t size)             { return sim_new(size); }
+extern "C" void  sim_delete(void *p)                     { sim_free(p); }
+extern "C" void  sim_delete_array(void *p)               { sim_free(p); }
+extern "C" void  sim_delete_sized(void *p, size_t)       { sim_free(p); }
+extern "C" void  sim_delete_array_sized(void *p, size_t) { sim_free(p); }
+
+/* String */
+static std::string number_to_string(unsigned long value, unsigned char base, bool negative) {
+  std::string digits;
+
+  do {
+    unsigned long digit = value % base;
+    digits.insert(digits.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+    value /= base;
+  } while ( value );
+
+  if ( negative ) { digits.insert(digits.begin(), '-'); }
+  return digits;
+}
+
+// Like Arduino's String: the text and its terminator live in a malloc()ed buffer that is grown when needed
+void String::hold() {
+  if ( buffer.length() + 1 > held ) {
+    sim::stats.heap_bytes += buffer.length() + 1 - held;
+    held = buffer.length() + 1;
+    if ( sim::stats.heap_bytes > sim::stats.heap_peak ) { sim::stats.heap_peak = sim::stats.heap_bytes; }
+  }
+}
+
+String::~String() { sim::stats.heap_bytes -= held; }
+
+String::String(const char *cstr)                     : buffer(cstr ? cstr : "") { hold(); }
+String::String(const String &str)                    : buffer(str.buffer) { hold(); }
+String::String(const __FlashStringHelper *str)       : buffer((const char *)str) { hold(); }
+String::String(char c)                               : buffer(1, c) { hold(); }
+String::String(unsigned char value, unsigned char base) : buffer(number_to_string(value, base, false)) { hold(); }
+String::String(unsigned int value, unsigned char base)  : buffer(number_to_string(value, base, false)) { hold(); }
+String::String(unsigned long value, unsigned char base) : buffer(number_to_string(value, base, false)) { hold(); }
+
+String::String(int value, unsigned char base)
+  : buffer(base == DEC ? number_to_string(value < 0 ? -(long)value : value, base, value < 0)
+                       : number_to_string((unsigned int)value, base, false)) { hold(); }
+
+String::String(long value, unsigned char base)
+  : buffer(base == DEC ? number_to_string(value < 0 ? -value : value, base, value < 0)
+                       : number_to_string((unsigned long)value, base, false)) { hold(); }
+
+String &String::operator =(const String &rhs)   { buffer = rhs.buffer;          hold(); return *this; }
+String &String::operator =(const char *cstr)    { buffer = cstr ? cstr : "";    hold(); return *this; }
+String &String::operator +=(const String &rhs)  { buffer += rhs.buffer;         hold(); return *this; }
+String &String::operator +=(const char *cstr)   { if ( cstr ) { buffer += cstr; } hold(); return *this; }
+String &String::operator +=(char c)             { buffer += c;                  hold(); return *this; }
+
+String operator +(const String &lhs, const String &rhs) { String s(lhs); s += rhs; return s; }
+String operator +(const String &lhs, const char *rhs)   { String s(lhs); s += rhs; return s; }
+String operator +(const char *lhs, const String &rhs)   { String s(lhs); s += rhs; return s; }
+
+/* Print */
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while ( size-- ) { n += write(*buffer++); }
+  return n;
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  return write(number_to_string(n, base < 2 ? 10 : base, false).c_str());
+}
+
+size_t Print::print(const __FlashStringHelper *str) { return write((const char *)str); }
+size_t Print::print(const String &str)              { return write(str.c_str()); }
+size_t Print::print(const char *str)                { return write(str); }
+size_t Print::print(char c)                         { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base)  { return printNumber(value, base); }
+size_t Print::print(unsigned int value, int base)   { return printNumber(value, base); }
+size_t Print::print(unsigned long value, int base)  { return printNumber(value, base); }
+size_t Print::print(int value, int base)            { return print((long)value, base); }
+
+size_t Print::print(long value, int base) {
+  if ( base == DEC && value < 0 ) {
+    return write('-') + printNumber(-value, DEC);
+  }
+  return printNumber((unsigned long)value, base);
+}
+
+size_t Print::print(double value, int digits) {
+  char tmp[32];
+  snprintf(tmp, sizeof(tmp), "%.*f", digits, value);
+  return write(tmp);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+/* USB Serial; 64 byte transmit buffer draining at the configured baud rate */
+HardwareSerial Serial;
+
+static bool               serial_echo_enabled = false;
+static uint64_t           serial_byte_us      = 1042;
+static uint64_t           serial_busy_until   = 0;
+static std::deque<uint8_t> &serial_input() {
+  static std::deque<uint8_t> input;
+  return input;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+  serial_byte_us = 10000000UL / baud;
+}
+
+int HardwareSerial::available() {
+  return serial_input().size();
+}
+
+int HardwareSerial::read() {
+  if ( serial_input().empty() ) { return -1; }
+  uint8_t b = serial_input().front();
+  serial_input().pop_front();
+  return b;
+}
+
+int HardwareSerial::peek() {
+  return serial_input().empty() ? -1 : serial_input().front();
+}
+
+size_t HardwareSerial::write(uint8_t b) {
+  // Block while the transmit buffer is full, like the real driver does
+  if ( serial_busy_until < sim::now_us() ) { serial_busy_until = sim::now_us(); }
+  uint64_t backlog = serial_busy_until - sim::now_us();
+  if ( backlog > 64 * serial_byte_us ) { sim::advance_us(backlog - 64 * serial_byte_us); }
+  serial_busy_until += serial_byte_us;
+
+  sim::stats.serial_tx_bytes++;
+  if ( serial_echo_enabled && b != '\r' ) { putchar(b); }
+  return 1;
+}
+
+namespace sim {
+
+void serial_echo(bool enable) {
+  serial_echo_enabled = enable;
+}
+
+void serial_inject(const char *text) {
+  while ( *text ) { serial_input().push_back((uint8_t)*text++); }
+}
+
+}
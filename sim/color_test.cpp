@@ -0,0 +1,59 @@
+/*
+ * Host simulation - packed color test
+ *
+ * Checks the packed color math of color.h against the same math done channel by channel: colorAdd() for every
+ * pair of channel values in every channel, with the other channels busy, and packColor() / unpackColor() for
+ * every value of every channel.
+ *
+ * Usage: color_test      -- exits 1 on the first mismatch
+ *
+ */
+
+#include <Arduino.h>
+
+#include "../color.h"
+
+static uint32_t checks = 0;
+
+// colorAdd() one channel at a time, the way it's done without packing
+static Color reference(Color a, Color b) {
+  Color sum = 0;
+
+  for ( uint8_t shift = 0; shift <= 16; shift += 8 ) {
+    uint16_t channel = ( ( a >> shift ) & 0xFF ) + ( ( b >> shift ) & 0xFF );
+    sum |= (Color)( channel > 255 ? 255 : channel ) << shift;
+  }
+  return sum;
+}
+
+static bool checkAdd(Color a, Color b) {
+  checks++;
+  if ( colorAdd(a, b) != reference(a, b) ) {
+    printf("colorAdd(0x%06X, 0x%06X) = 0x%06X; expected 0x%06X\n", a, b, colorAdd(a, b), reference(a, b));
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  for ( uint16_t x = 0; x < 256; x++ ) {
+    for ( uint16_t y = 0; y < 256; y++ ) {
+      // The pair in each channel; the neighbours carry the values that would show a carry or borrow between them
+      if ( !checkAdd(packColor(x, 255 - x, y),  packColor(y, 255 - y, x))  ||
+           !checkAdd(packColor(y, x, 255 - y),  packColor(x, y, 255 - x))  ||
+           !checkAdd(packColor(255, y, x),      packColor(255, x, y)) ) {
+        return 1;
+      }
+    }
+
+    CRGB c = unpackColor(packColor(x, 255 - x, x ^ 0x5A));
+    checks++;
+    if ( c.r != x || c.g != 255 - x || c.b != ( x ^ 0x5A ) || packColor(c) != packColor(x, 255 - x, x ^ 0x5A) ) {
+      printf("packColor() / unpackColor() don't round trip %d\n", x);
+      return 1;
+    }
+  }
+
+  printf("color_checks=%u\n", checks);
+  return 0;
+}
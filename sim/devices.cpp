@@ -0,0 +1,689 @@
+/*
+ * Host simulation - devices
+ *
+ * FastLED output, the I2C bus with the DS1307, RTClib, EEPROM, SoftwareSerial
+ * and the YX5300 MP3 module it is wired to.
+ *
+ */
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <Wire.h>
+#include <RTClib.h>
+#include <EEPROM.h>
+#include <SoftwareSerial.h>
+#include <sim.h>
+
+#include <map>
+#include <vector>
+
+/* FastLED; WS2812 at 800 kHz is 30 us per LED plus a 50 us latch */
+CFastLED FastLED;
+
+static uint8_t scale8(uint8_t value, uint8_t scale) {
+  return ((uint16_t)value * (1 + (uint16_t)scale)) >> 8;
+}
+
+void CFastLED::push(const CRGB *data, bool single) {
+  int count = size();
+  if ( count > (int)(sizeof(m_shown) / sizeof(m_shown[0])) ) { count = sizeof(m_shown) / sizeof(m_shown[0]); }
+
+  for ( int i = 0; i < count; i++ ) {
+    const CRGB &c = single ? data[0] : data[i];
+    m_shown[i] = CRGB(scale8(c.r, m_brightness), scale8(c.g, m_brightness), scale8(c.b, m_brightness));
+  }
+
+  sim::stats.frames++;
+  sim::irq_off_us(30 * count + 50);
+}
+
+void CFastLED::show() {
+  if ( leds() ) { push(leds(), false); }
+}
+
+void CFastLED::showColor(const CRGB &color) {
+  push(&color, true);
+}
+
+void CFastLED::clear(bool writeData) {
+  for ( int i = 0; i < size(); i++ ) { leds()[i] = CRGB(0, 0, 0); }
+  if ( writeData ) { show(); }
+}
+
+/* DS1307; time registers 0x00-0x06, control 0x07, battery backed RAM 0x08-0x3F */
+static uint8_t bin2bcd(uint8_t val) { return val + 6 * (val / 10); }
+static uint8_t bcd2bin(uint8_t val) { return val - 6 * (val >> 4); }
+
+#define SQW_PIN 3         // SQW/OUT is wired to D3 (INT1)
+
+static struct {
+  bool     connected;
+  bool     running;
+  uint32_t base_unix;     // RTC time at base_us
+  uint64_t base_us;
+  uint8_t  reg[64];
+  uint8_t  pointer;
+  bool     sqw_connected;
+  uint32_t sqw_generation; // Edges scheduled under an older generation are dropped
+} ds1307 = { true, true, SECONDS_FROM_1970_TO_2000, 0, { 0 }, 0, true, 0 };
+
+static uint32_t ds1307_unixtime() {
+  if ( !ds1307.running ) { return ds1307.base_unix; }
+  return ds1307.base_unix + (uint32_t)((sim::now_us() - ds1307.base_us) / 1000000);
+}
+
+// SQW/OUT in 1 Hz mode falls where a second starts and rises halfway
+static void ds1307_sqw_edge(uint32_t generation, uint64_t when, bool falling) {
+  sim::at_us(when, [generation, when, falling]() {
+    if ( ds1307.sqw_generation != generation ) { return; }
+    if ( ds1307.sqw_connected ) { sim::pin_edge(SQW_PIN, falling ? FALLING : RISING); }
+    ds1307_sqw_edge(generation, when + 500000, !falling);
+  });
+}
+
+// The countdown chain restarts when the time is written; the square wave restarts with it
+static void ds1307_sqw_restart() {
+  uint32_t generation = ++ds1307.sqw_generation;
+
+  if ( !ds1307.running || ( ds1307.reg[7] & 0x13 ) != 0x10 ) { return; }
+
+  uint64_t elapsed = ( sim::now_us() - ds1307.base_us ) % 1000000;
+  uint64_t next    = sim::now_us() - elapsed + ( elapsed < 500000 ? 500000 : 1000000 );
+  ds1307_sqw_edge(generation, next, elapsed >= 500000);
+}
+
+static void ds1307_latch_time() {
+  DateTime now(ds1307_unixtime());
+
+  ds1307.reg[0] = bin2bcd(now.second()) | (ds1307.running ? 0x00 : 0x80);
+  ds1307.reg[1] = bin2bcd(now.minute());
+  ds1307.reg[2] = bin2bcd(now.hour());
+  ds1307.reg[3] = now.dayOfTheWeek() + 1;
+  ds1307.reg[4] = bin2bcd(now.day());
+  ds1307.reg[5] = bin2bcd(now.month());
+  ds1307.reg[6] = bin2bcd(now.year() - 2000);
+}
+
+static void ds1307_store_time() {
+  DateTime set(bcd2bin(ds1307.reg[6]) + 2000, bcd2bin(ds1307.reg[5]), bcd2bin(ds1307.reg[4]),
+               bcd2bin(ds1307.reg[2]), bcd2bin(ds1307.reg[1]), bcd2bin(ds1307.reg[0] & 0x7F));
+
+  ds1307.running   = !(ds1307.reg[0] & 0x80);
+  ds1307.base_unix = set.unixtime();
+  ds1307.base_us   = sim::now_us();   // Writing the seconds resets the countdown chain
+  ds1307_sqw_restart();
+}
+
+namespace sim {
+
+void rtc_set(uint32_t unixtime, bool running) {
+  ds1307.base_unix = unixtime;
+  ds1307.base_us   = now_us();
+  ds1307.running   = running;
+  ds1307_sqw_restart();
+}
+
+int64_t rtc_second_us(uint32_t unixtime) {
+  return (int64_t)ds1307.base_us + ( (int64_t)unixtime - ds1307.base_unix ) * 1000000;
+}
+
+uint32_t rtc_unixtime() {
+  return ds1307_unixtime();
+}
+
+void rtc_connected(bool connected) {
+  ds1307.connected = connected;
+}
+
+void rtc_sqw_connected(bool connected) {
+  ds1307.sqw_connected = connected;
+}
+
+}
+
+/* Wire; 100 kHz, nine clocks per byte */
+TwoWire Wire;
+
+static void i2c_bytes(uint8_t count) {
+  sim::stats.i2c_transactions++;
+  sim::advance_us(90 * (1 + count));
+}
+
+void TwoWire::begin() {
+  txLength = 0;
+  rxIndex  = 0;
+  rxLength = 0;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address;
+  txLength  = 0;
+}
+
+size_t TwoWire::write(uint8_t b) {
+  if ( txLength >= BUFFER_LENGTH ) { return 0; }
+  txBuffer[txLength++] = b;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  size_t n = 0;
+  while ( quantity-- ) { n += write(*data++); }
+  return n;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  i2c_bytes(txLength);
+
+  if ( txAddress != DS1307_ADDRESS || !ds1307.connected ) { return 2; }   // NACK on address
+  if ( txLength == 0 ) { return 0; }
+
+  ds1307_latch_time();
+  ds1307.pointer = txBuffer[0] & 0x3F;
+
+  bool time_written    = false;
+  bool control_written = false;
+  for ( uint8_t i = 1; i < txLength; i++ ) {
+    if ( ds1307.pointer <= 0x06 ) { time_written = true; }
+    if ( ds1307.pointer == 0x07 ) { control_written = true; }
+    ds1307.reg[ds1307.pointer] = txBuffer[i];
+    ds1307.pointer = (ds1307.pointer + 1) & 0x3F;
+  }
+
+  if ( time_written ) {
+    ds1307_store_time();
+  } else if ( control_written ) {
+    ds1307_sqw_restart();
+  }
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool) {
+  i2c_bytes(quantity);
+
+  rxIndex  = 0;
+  rxLength = 0;
+  if ( address != DS1307_ADDRESS || !ds1307.connected ) { return 0; }
+  if ( quantity > BUFFER_LENGTH ) { quantity = BUFFER_LENGTH; }
+
+  ds1307_latch_time();
+  for ( uint8_t i = 0; i < quantity; i++ ) {
+    rxBuffer[rxLength++] = ds1307.reg[ds1307.pointer];
+    ds1307.pointer = (ds1307.pointer + 1) & 0x3F;
+  }
+  return rxLength;
+}
+
+int TwoWire::available() {
+  return rxLength - rxIndex;
+}
+
+int TwoWire::read() {
+  return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+  return rxIndex < rxLength ? rxBuffer[rxIndex] : -1;
+}
+
+/* RTClib DateTime */
+static const uint8_t daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+static uint16_t date2days(uint16_t y, uint8_t m, uint8_t d) {
+  if ( y >= 2000 ) { y -= 2000; }
+  uint16_t days = d;
+  for ( uint8_t i = 1; i < m; ++i ) { days += daysInMonth[i - 1]; }
+  if ( m > 2 && y % 4 == 0 ) { ++days; }
+  return days + 365 * y + (y + 3) / 4 - 1;
+}
+
+static long time2long(uint16_t days, uint8_t h, uint8_t m, uint8_t s) {
+  return ((days * 24L + h) * 60 + m) * 60 + s;
+}
+
+static uint8_t conv2d(const char *p) {
+  uint8_t v = 0;
+  if ( '0' <= *p && *p <= '9' ) { v = *p - '0'; }
+  return 10 * v + *++p - '0';
+}
+
+DateTime::DateTime(uint32_t t) {
+  t -= SECONDS_FROM_1970_TO_2000;
+
+  ss = t % 60; t /= 60;
+  mm = t % 60; t /= 60;
+  hh = t % 24;
+  uint16_t days = t / 24;
+  uint8_t  leap;
+  for ( yOff = 0; ; ++yOff ) {
+    leap = yOff % 4 == 0;
+    if ( days < 365U + leap ) { break; }
+    days -= 365 + leap;
+  }
+  for ( m = 1; m < 12; ++m ) {
+    uint8_t daysPerMonth = daysInMonth[m - 1];
+    if ( leap && m == 2 ) { ++daysPerMonth; }
+    if ( days < daysPerMonth ) { break; }
+    days -= daysPerMonth;
+  }
+  d = days + 1;
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec) {
+  if ( year >= 2000 ) { year -= 2000; }
+  yOff = year;
+  m    = month;
+  d    = day;
+  hh   = hour;
+  mm   = min;
+  ss   = sec;
+}
+
+DateTime::DateTime(const DateTime &copy)
+  : yOff(copy.yOff), m(copy.m), d(copy.d), hh(copy.hh), mm(copy.mm), ss(copy.ss) {}
+
+DateTime::DateTime(const char *date, const char *time) {
+  // sample input: date = "Dec 26 2009", time = "12:34:56"
+  yOff = conv2d(date + 9);
+  switch ( date[0] ) {
+    case 'J': m = (date[1] == 'a') ? 1 : ((date[2] == 'n') ? 6 : 7); break;
+    case 'F': m = 2; break;
+    case 'A': m = date[2] == 'r' ? 4 : 8; break;
+    case 'M': m = date[2] == 'r' ? 3 : 5; break;
+    case 'S': m = 9; break;
+    case 'O': m = 10; break;
+    case 'N': m = 11; break;
+    case 'D': m = 12; break;
+  }
+  d  = conv2d(date + 4);
+  hh = conv2d(time);
+  mm = conv2d(time + 3);
+  ss = conv2d(time + 6);
+}
+
+uint8_t DateTime::dayOfTheWeek() const {
+  uint16_t day = date2days(yOff, m, d);
+  return (day + 6) % 7;   // Jan 1, 2000 is a Saturday, i.e. returns 6
+}
+
+long DateTime::secondstime() const {
+  return time2long(date2days(yOff, m, d), hh, mm, ss);
+}
+
+uint32_t DateTime::unixtime() const {
+  return time2long(date2days(yOff, m, d), hh, mm, ss) + SECONDS_FROM_1970_TO_2000;
+}
+
+DateTime DateTime::operator +(const TimeSpan &span) { return DateTime(unixtime() + span.totalseconds()); }
+DateTime DateTime::operator -(const TimeSpan &span) { return DateTime(unixtime() - span.totalseconds()); }
+TimeSpan DateTime::operator -(const DateTime &right) { return TimeSpan(unixtime() - right.unixtime()); }
+
+/* RTClib RTC_DS1307 */
+bool RTC_DS1307::begin() {
+  return true;
+}
+
+uint8_t RTC_DS1307::isrunning() {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)0);
+  Wire.endTransmission();
+
+  Wire.requestFrom(DS1307_ADDRESS, 1);
+  uint8_t ss = Wire.read();
+  return !(ss >> 7);
+}
+
+void RTC_DS1307::adjust(const DateTime &dt) {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)0);
+  Wire.write(bin2bcd(dt.second()));
+  Wire.write(bin2bcd(dt.minute()));
+  Wire.write(bin2bcd(dt.hour()));
+  Wire.write(bin2bcd(0));
+  Wire.write(bin2bcd(dt.day()));
+  Wire.write(bin2bcd(dt.month()));
+  Wire.write(bin2bcd(dt.year() - 2000));
+  Wire.endTransmission();
+}
+
+DateTime RTC_DS1307::now() {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)0);
+  Wire.endTransmission();
+
+  Wire.requestFrom(DS1307_ADDRESS, 7);
+  uint8_t ss = bcd2bin(Wire.read() & 0x7F);
+  uint8_t mm = bcd2bin(Wire.read());
+  uint8_t hh = bcd2bin(Wire.read());
+  Wire.read();
+  uint8_t d  = bcd2bin(Wire.read());
+  uint8_t m  = bcd2bin(Wire.read());
+  uint16_t y = bcd2bin(Wire.read()) + 2000;
+
+  return DateTime(y, m, d, hh, mm, ss);
+}
+
+Ds1307SqwPinMode RTC_DS1307::readSqwPinMode() {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)0x07);
+  Wire.endTransmission();
+
+  Wire.requestFrom(DS1307_ADDRESS, 1);
+  return (Ds1307SqwPinMode)(Wire.read() & 0x93);
+}
+
+void RTC_DS1307::writeSqwPinMode(Ds1307SqwPinMode mode) {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)0x07);
+  Wire.write((uint8_t)mode);
+  Wire.endTransmission();
+}
+
+void RTC_DS1307::readnvram(uint8_t *buf, uint8_t size, uint8_t address) {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)(0x08 + address));
+  Wire.endTransmission();
+
+  Wire.requestFrom(DS1307_ADDRESS, size);
+  for ( uint8_t i = 0; i < size; i++ ) { buf[i] = Wire.read(); }
+}
+
+uint8_t RTC_DS1307::readnvram(uint8_t address) {
+  uint8_t data;
+  readnvram(&data, 1, address);
+  return data;
+}
+
+void RTC_DS1307::writenvram(uint8_t address, uint8_t *buf, uint8_t size) {
+  Wire.beginTransmission(DS1307_ADDRESS);
+  Wire.write((uint8_t)(0x08 + address));
+  for ( uint8_t i = 0; i < size; i++ ) { Wire.write(buf[i]); }
+  Wire.endTransmission();
+}
+
+void RTC_DS1307::writenvram(uint8_t address, uint8_t data) {
+  writenvram(address, &data, 1);
+}
+
+/* RTClib RTC_Millis */
+long RTC_Millis::offset = 0;
+
+void RTC_Millis::adjust(const DateTime &dt) {
+  offset = dt.unixtime() - millis() / 1000;
+}
+
+DateTime RTC_Millis::now() {
+  return (uint32_t)(offset + millis() / 1000);
+}
+
+/* EEPROM; 3.3 ms erase/write cycle */
+EEPROMClass EEPROM;
+
+static uint8_t  eeprom_cells[E2END + 1];
+static uint32_t eeprom_writes[E2END + 1];
+static bool     eeprom_erased = false;
+
+static void eeprom_erase() {
+  if ( !eeprom_erased ) {
+    memset(eeprom_cells, 0xFF, sizeof(eeprom_cells));
+    eeprom_erased = true;
+  }
+}
+
+uint8_t EEPROMClass::read(int address) {
+  eeprom_erase();
+  return eeprom_cells[address & E2END];
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  eeprom_erase();
+  eeprom_cells[address & E2END] = value;
+  eeprom_writes[address & E2END]++;
+  sim::stats.eeprom_writes++;
+  sim::advance_us(3300);
+}
+
+namespace sim {
+
+uint8_t eeprom_peek(int address) {
+  eeprom_erase();
+  return eeprom_cells[address & E2END];
+}
+
+void eeprom_poke(int address, uint8_t value) {
+  eeprom_erase();
+  eeprom_cells[address & E2END] = value;
+}
+
+uint32_t eeprom_cell_writes(int address) {
+  return eeprom_writes[address & E2END];
+}
+
+}
+
+/*
+ * YX5300 MP3 module
+ *
+ * Decodes 7E FF 06 CMD FB DH DL [CH CL] EF command frames, answers with
+ * 10 byte 7E FF 06 CMD 00 DH DL CH CL EF frames and plays samples for their
+ * configured duration before reporting 0x3D (finished). Samples without a
+ * configured duration take 500 ms plus 25 ms for every file number % 8. A
+ * play command stops the sample that is playing.
+ */
+static SoftwareSerial *mp3_port = 0;
+
+static struct {
+  std::vector<uint8_t>          frame;
+  uint64_t                      frame_start;
+  uint64_t                      frame_end;       // End of the previous command frame
+  uint64_t                      line_busy_until;
+  bool                          sleeping;
+  bool                          playing;
+  uint32_t                      generation;
+  uint64_t                      sample_end;      // When the last sample started ends or ended
+  uint64_t                      awake_since;
+  std::map<uint16_t, uint16_t>  durations;
+} mp3 = { std::vector<uint8_t>(), 0, 0, 0, false, false, 0, 0, 0, std::map<uint16_t, uint16_t>() };
+
+// Count the time awake up to now; the module is awake from power on
+static void mp3_awake_count() {
+  if ( !mp3.sleeping ) { sim::stats.mp3_awake_us += sim::now_us() - mp3.awake_since; }
+  mp3.awake_since = sim::now_us();
+}
+
+static const uint64_t MP3_BYTE_US   = 1042;   // 9600 baud, 10 bits
+static const uint64_t MP3_REPLY_US  = 15000;  // Command processing time before the reply
+static const uint64_t MP3_GAP_US    = 20000;  // Quiet time the module wants between two commands
+
+static void mp3_reply(uint64_t when, uint8_t command, uint16_t data) {
+  uint8_t  reply[10] = { 0x7E, 0xFF, 0x06, command, 0x00, (uint8_t)(data >> 8), (uint8_t)data, 0, 0, 0xEF };
+  uint16_t checksum  = 0;
+  for ( uint8_t i = 1; i < 7; i++ ) { checksum -= reply[i]; }
+  reply[7] = checksum >> 8;
+  reply[8] = checksum;
+
+  if ( mp3.line_busy_until > when ) { when = mp3.line_busy_until; }
+  for ( uint8_t i = 0; i < sizeof(reply); i++ ) {
+    uint8_t b = reply[i];
+    sim::at_us(when + i * MP3_BYTE_US, [b]() { if ( mp3_port ) { mp3_port->receive(b); } });
+  }
+  mp3.line_busy_until = when + sizeof(reply) * MP3_BYTE_US;
+}
+
+static void mp3_command(uint8_t command, bool feedback, uint16_t data) {
+  uint64_t now = sim::now_us();
+  sim::stats.mp3_commands++;
+
+  switch ( command ) {
+    case 0x0A:  // Sleep
+      mp3_awake_count();
+      mp3.sleeping = true;
+      mp3.playing  = false;
+      mp3.generation++;
+      break;
+
+    case 0x0B:  // Wake up
+      mp3_awake_count();
+      mp3.sleeping = false;
+      break;
+
+    case 0x0C:  // Reset
+      mp3_awake_count();
+      mp3.sleeping = false;
+      mp3.playing  = false;
+      mp3.generation++;
+      break;
+
+    case 0x0F: { // Play folder / file
+      if ( mp3.sleeping ) {
+        mp3_reply(now + MP3_REPLY_US, 0x40, 0x0001);
+        return;
+      }
+
+      uint8_t  file     = data & 0xFF;
+      uint16_t duration = 500 + 25 * ( file % 8 );
+      std::map<uint16_t, uint16_t>::iterator it = mp3.durations.find(data);
+      if ( it != mp3.durations.end() ) { duration = it->second; }
+
+      uint64_t start = now + MP3_REPLY_US;
+      if ( mp3.playing && start < mp3.sample_end ) {
+        sim::stats.mp3_samples_cut++;
+      } else if ( mp3.sample_end && start - mp3.sample_end < 1000000 ) {
+        uint64_t gap = start - mp3.sample_end;
+        sim::stats.mp3_word_gaps++;
+        sim::stats.mp3_word_gap_us += gap;
+        if ( gap > sim::stats.mp3_word_gap_us_max ) { sim::stats.mp3_word_gap_us_max = gap; }
+      } else {
+        uint32_t rtc   = sim::rtc_unixtime();
+        uint64_t delay = start - sim::rtc_second_us(rtc - rtc % 60);
+        sim::stats.mp3_sentences++;
+        sim::stats.mp3_sentence_delay_us += delay;
+        if ( delay > sim::stats.mp3_sentence_delay_us_max ) { sim::stats.mp3_sentence_delay_us_max = delay; }
+      }
+
+      uint32_t generation = ++mp3.generation;
+      mp3.playing    = true;
+      mp3.sample_end = start + duration * 1000ULL;
+      sim::stats.mp3_samples++;
+      sim::at_us(mp3.sample_end, [generation, file]() {
+        if ( mp3.generation != generation ) { return; }
+        mp3.playing = false;
+        mp3_reply(sim::now_us(), 0x3D, file);
+      });
+      break;
+    }
+
+    case 0x16:  // Stop
+      mp3.playing = false;
+      mp3.generation++;
+      break;
+
+    case 0x42:  // Query status
+      mp3_reply(now + MP3_REPLY_US, 0x42, mp3.sleeping ? 0x0200 : (mp3.playing ? 0x0201 : 0x0200));
+      break;
+
+    case 0x48:  // Query total tracks
+      mp3_reply(now + MP3_REPLY_US, 0x48, 60);
+      break;
+
+    case 0x4E:  // Query tracks in folder
+      mp3_reply(now + MP3_REPLY_US, 0x4E, 20);
+      break;
+
+    case 0x4F:  // Query folder count
+      mp3_reply(now + MP3_REPLY_US, 0x4F, 3);
+      break;
+  }
+
+  if ( feedback ) { mp3_reply(now + MP3_REPLY_US, 0x41, 0x0000); }
+}
+
+static void mp3_receive(uint8_t b) {
+  if ( mp3.frame.empty() && b != 0x7E ) { return; }
+  if ( mp3.frame.empty() ) { mp3.frame_start = sim::now_us() - MP3_BYTE_US; }
+  mp3.frame.push_back(b);
+
+  if ( b == 0xEF && (mp3.frame.size() == 8 || mp3.frame.size() == 10) ) {
+    std::vector<uint8_t> f = mp3.frame;
+    mp3.frame.clear();
+
+    if ( mp3.frame_end && mp3.frame_start < mp3.frame_end + MP3_GAP_US ) { sim::stats.mp3_tx_early++; }
+    mp3.frame_end = sim::now_us();
+    mp3_command(f[3], f[4] == 0x01, (f[5] << 8) | f[6]);
+  } else if ( mp3.frame.size() >= 10 ) {
+    mp3.frame.clear();
+  }
+}
+
+namespace sim {
+
+uint64_t mp3_awake_us() {
+  mp3_awake_count();
+  return stats.mp3_awake_us;
+}
+
+void mp3_sample_ms(uint8_t folder, uint8_t file, uint16_t duration) {
+  mp3.durations[(folder << 8) | file] = duration;
+}
+
+}
+
+/* SoftwareSerial; transmit is bit-banged with interrupts disabled, receive
+ * holds the CPU in the pin change interrupt for the rest of the byte */
+SoftwareSerial::SoftwareSerial(uint8_t, uint8_t, bool)
+  : baud(9600), rxHead(0), rxTail(0), rxOverflow(false) {
+  mp3_port = this;
+}
+
+void SoftwareSerial::begin(long speed) {
+  baud = speed;
+}
+
+bool SoftwareSerial::overflow() {
+  bool ret   = rxOverflow;
+  rxOverflow = false;
+  return ret;
+}
+
+int SoftwareSerial::available() {
+  return (rxTail + _SS_MAX_RX_BUFF - rxHead) % _SS_MAX_RX_BUFF;
+}
+
+int SoftwareSerial::read() {
+  if ( rxHead == rxTail ) { return -1; }
+  uint8_t b = rxBuffer[rxHead];
+  rxHead = (rxHead + 1) % _SS_MAX_RX_BUFF;
+  return b;
+}
+
+int SoftwareSerial::peek() {
+  return rxHead == rxTail ? -1 : rxBuffer[rxHead];
+}
+
+size_t SoftwareSerial::write(uint8_t b) {
+  sim::stats.mp3_tx_bytes++;
+  sim::irq_off_us(10000000UL / baud);
+  mp3_receive(b);
+  return 1;
+}
+
+void SoftwareSerial::receive(uint8_t b) {
+  sim::stats.mp3_rx_bytes++;
+
+  // The start bit edge was missed; the byte is sampled at the wrong bit times
+  if ( sim::irq_disabled() ) {
+    sim::stats.mp3_rx_garbled++;
+    b = (b >> 1) | 0x80;
+  }
+
+  sim::steal_us(95000000UL / baud / 10);
+
+  uint8_t next = (rxTail + 1) % _SS_MAX_RX_BUFF;
+  if ( next == rxHead ) {
+    sim::stats.mp3_rx_overflow++;
+    rxOverflow = true;
+    return;
+  }
+  rxBuffer[rxTail] = b;
+  rxTail = next;
+}
@@ -0,0 +1,170 @@
+/*
+ * Host simulation - Arduino core stand-in
+ *
+ * Provides just enough of the Arduino AVR core for the clock sketch to compile
+ * and run on a Linux host. Time is virtual: millis() / micros() read the
+ * simulated clock and delay() lets simulated time pass (see sim.h).
+ *
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+
+#include <avr/pgmspace.h>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH            0x1
+#define LOW             0x0
+
+#define INPUT           0x0
+#define OUTPUT          0x1
+#define INPUT_PULLUP    0x2
+
+#define CHANGE          1
+#define FALLING         2
+#define RISING          3
+
+#define LED_BUILTIN     13
+
+#define NOT_AN_INTERRUPT          -1
+#define digitalPinToInterrupt(p)  ((p) == 2 ? 0 : ((p) == 3 ? 1 : NOT_AN_INTERRUPT))
+
+#define A0              14
+#define A1              15
+#define A2              16
+#define A3              17
+#define A4              18
+#define A5              19
+#define A6              20
+#define A7              21
+
+#define DEC             10
+#define HEX             16
+#define OCT             8
+#define BIN             2
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+#define noInterrupts()
+#define interrupts()
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+
+void          pinMode(uint8_t pin, uint8_t mode);
+void          digitalWrite(uint8_t pin, uint8_t val);
+int           digitalRead(uint8_t pin);
+
+void          attachInterrupt(uint8_t interrupt, void (*isr)(), int mode);
+void          detachInterrupt(uint8_t interrupt);
+
+long          random(long howbig);
+long          random(long howsmall, long howbig);
+void          randomSeed(unsigned long seed);
+long          map(long x, long in_min, long in_max, long out_min, long out_max);
+
+/* String */
+class String {
+public:
+  String(const char *cstr = "");
+  ~String();
+  String(const String &str);
+  String(const __FlashStringHelper *str);
+  explicit String(char c);
+  explicit String(unsigned char value, unsigned char base = DEC);
+  explicit String(int value, unsigned char base = DEC);
+  explicit String(unsigned int value, unsigned char base = DEC);
+  explicit String(long value, unsigned char base = DEC);
+  explicit String(unsigned long value, unsigned char base = DEC);
+
+  String &operator =(const String &rhs);
+  String &operator =(const char *cstr);
+
+  String &operator +=(const String &rhs);
+  String &operator +=(const char *cstr);
+  String &operator +=(char c);
+
+  friend String operator +(const String &lhs, const String &rhs);
+  friend String operator +(const String &lhs, const char *rhs);
+  friend String operator +(const char *lhs, const String &rhs);
+
+  bool operator ==(const String &rhs) const { return buffer == rhs.buffer; }
+  bool operator ==(const char *cstr)  const { return buffer == cstr; }
+  bool operator !=(const String &rhs) const { return buffer != rhs.buffer; }
+
+  unsigned int  length() const { return buffer.length(); }
+  const char   *c_str()  const { return buffer.c_str(); }
+  char          operator [](unsigned int index) const { return buffer[index]; }
+
+private:
+  std::string buffer;
+  size_t      held = 0;           // Bytes of heap taken for the buffer; Arduino's String never gives any back
+
+  void hold();
+};
+
+/* Print / Stream */
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+
+  size_t print(const __FlashStringHelper *str);
+  size_t print(const String &str);
+  size_t print(const char *str);
+  size_t print(char c);
+  size_t print(unsigned char value, int base = DEC);
+  size_t print(int value, int base = DEC);
+  size_t print(unsigned int value, int base = DEC);
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+  size_t print(double value, int digits = 2);
+
+  size_t println();
+  template<typename T> size_t println(const T &value)           { size_t n = print(value);       return n + println(); }
+  template<typename T> size_t println(const T &value, int base) { size_t n = print(value, base); return n + println(); }
+
+private:
+  size_t printNumber(unsigned long n, uint8_t base);
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual void flush() {}
+};
+
+class HardwareSerial : public Stream {
+public:
+  void   begin(unsigned long baud);
+  void   end() {}
+  int    available();
+  int    read();
+  int    peek();
+  int    availableForWrite() { return 63; }   // Output is instant
+  size_t write(uint8_t b);
+  using  Print::write;
+  operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Host simulation - EEPROM stand-in
+ *
+ * 1 KB like the ATmega328P, erased to 0xFF. Every write that reaches a cell is
+ * counted per address and stalls the CPU for the erase/write cycle.
+ *
+ */
+
+#ifndef SIM_EEPROM_H
+#define SIM_EEPROM_H
+
+#include <Arduino.h>
+
+#define E2END 0x3FF
+
+class EEPROMClass {
+public:
+  uint8_t  read(int address);
+  void     write(int address, uint8_t value);
+  void     update(int address, uint8_t value) { if ( read(address) != value ) { write(address, value); } }
+  uint16_t length() { return E2END + 1; }
+
+  template<typename T> T &get(int address, T &t) {
+    uint8_t *ptr = (uint8_t *)&t;
+    for ( size_t i = 0; i < sizeof(T); i++ ) { ptr[i] = read(address + i); }
+    return t;
+  }
+
+  template<typename T> const T &put(int address, const T &t) {
+    const uint8_t *ptr = (const uint8_t *)&t;
+    for ( size_t i = 0; i < sizeof(T); i++ ) { update(address + i, ptr[i]); }
+    return t;
+  }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Host simulation - FastLED stand-in
+ *
+ * Implements the part of the FastLED API used by the clock. show() records the
+ * frame as it would appear on the strip (after brightness scaling) and charges
+ * the WS2812 transfer time with interrupts disabled.
+ *
+ */
+
+#ifndef SIM_FASTLED_H
+#define SIM_FASTLED_H
+
+#include <Arduino.h>
+
+struct CRGB {
+  union {
+    struct {
+      uint8_t r;
+      uint8_t g;
+      uint8_t b;
+    };
+    uint8_t raw[3];
+  };
+
+  CRGB() : r(0), g(0), b(0) {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+
+  uint8_t &operator [](uint8_t x)       { return raw[x]; }
+  uint8_t  operator [](uint8_t x) const { return raw[x]; }
+
+  bool operator ==(const CRGB &rhs) const { return r == rhs.r && g == rhs.g && b == rhs.b; }
+  bool operator !=(const CRGB &rhs) const { return !(*this == rhs); }
+};
+
+enum EOrder {
+  RGB = 0012,
+  RBG = 0021,
+  GRB = 0102,
+  GBR = 0120,
+  BRG = 0201,
+  BGR = 0210
+};
+
+#define DISABLE_DITHER  0x00
+#define BINARY_DITHER   0x01
+
+template<uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2811  {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812  {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER> class WS2812B {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER> class NEOPIXEL {};
+
+class CLEDController {
+public:
+  CLEDController() : m_data(0), m_nLeds(0) {}
+
+  CLEDController &setLeds(CRGB *data, int nLeds) { m_data = data; m_nLeds = nLeds; return *this; }
+  CRGB           *leds()                         { return m_data; }
+  int             size()                         { return m_nLeds; }
+
+private:
+  CRGB *m_data;
+  int   m_nLeds;
+};
+
+class CFastLED {
+public:
+  CFastLED() : m_brightness(255), m_dither(BINARY_DITHER) {}
+
+  template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+  CLEDController &addLeds(CRGB *data, int nLeds) {
+    return m_controller.setLeds(data, nLeds);
+  }
+
+  void            setBrightness(uint8_t scale) { m_brightness = scale; }
+  uint8_t         getBrightness()              { return m_brightness; }
+  void            setDither(uint8_t ditherMode) { m_dither = ditherMode; }
+
+  void            show();
+  void            showColor(const CRGB &color);
+  void            clear(bool writeData = false);
+
+  int             size()                { return m_controller.size(); }
+  CRGB           *leds()                { return m_controller.leds(); }
+  CLEDController &operator [](int)      { return m_controller; }
+
+  /* Simulation: the frame as last pushed to the strip, after brightness scaling */
+  const CRGB     &shown(int led) const  { return m_shown[led]; }
+
+private:
+  void            push(const CRGB *data, bool single);
+
+  CLEDController  m_controller;
+  uint8_t         m_brightness;
+  uint8_t         m_dither;
+  CRGB            m_shown[64];
+};
+
+extern CFastLED FastLED;
+
+#endif
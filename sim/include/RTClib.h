@@ -0,0 +1,95 @@
+/*
+ * Host simulation - RTClib stand-in
+ *
+ * DateTime, RTC_DS1307 and RTC_Millis with the same semantics as the Adafruit
+ * RTClib the sketch is built against. RTC_DS1307 talks to the simulated chip
+ * over Wire, register by register, like the real library.
+ *
+ */
+
+#ifndef SIM_RTCLIB_H
+#define SIM_RTCLIB_H
+
+#include <Arduino.h>
+
+#define SECONDS_PER_DAY           86400L
+#define SECONDS_FROM_1970_TO_2000 946684800
+
+#define DS1307_ADDRESS            0x68
+
+class TimeSpan;
+
+class DateTime {
+public:
+  DateTime(uint32_t t = SECONDS_FROM_1970_TO_2000);
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+  DateTime(const DateTime &copy);
+  DateTime(const char *date, const char *time);
+
+  uint16_t year()         const { return 2000 + yOff; }
+  uint8_t  month()        const { return m; }
+  uint8_t  day()          const { return d; }
+  uint8_t  hour()         const { return hh; }
+  uint8_t  minute()       const { return mm; }
+  uint8_t  second()       const { return ss; }
+  uint8_t  dayOfTheWeek() const;
+
+  long     secondstime()  const;
+  uint32_t unixtime()     const;
+
+  DateTime operator +(const TimeSpan &span);
+  DateTime operator -(const TimeSpan &span);
+  TimeSpan operator -(const DateTime &right);
+
+protected:
+  uint8_t yOff, m, d, hh, mm, ss;
+};
+
+class TimeSpan {
+public:
+  TimeSpan(int32_t seconds = 0) : _seconds(seconds) {}
+  TimeSpan(int16_t days, int8_t hours, int8_t minutes, int8_t seconds)
+    : _seconds((int32_t)days * 86400L + (int32_t)hours * 3600 + (int32_t)minutes * 60 + seconds) {}
+
+  int32_t totalseconds() const { return _seconds; }
+
+protected:
+  int32_t _seconds;
+};
+
+enum Ds1307SqwPinMode {
+  DS1307_OFF              = 0x00,
+  DS1307_ON               = 0x80,
+  DS1307_SquareWave1HZ    = 0x10,
+  DS1307_SquareWave4kHz   = 0x11,
+  DS1307_SquareWave8kHz   = 0x12,
+  DS1307_SquareWave32kHz  = 0x13
+};
+
+class RTC_DS1307 {
+public:
+  bool             begin();
+  static void      adjust(const DateTime &dt);
+  uint8_t          isrunning();
+  static DateTime  now();
+
+  static Ds1307SqwPinMode readSqwPinMode();
+  static void      writeSqwPinMode(Ds1307SqwPinMode mode);
+
+  uint8_t          readnvram(uint8_t address);
+  void             readnvram(uint8_t *buf, uint8_t size, uint8_t address);
+  void             writenvram(uint8_t address, uint8_t data);
+  void             writenvram(uint8_t address, uint8_t *buf, uint8_t size);
+};
+
+class RTC_Millis {
+public:
+  static void      begin(const DateTime &dt) { adjust(dt); }
+  static void      adjust(const DateTime &dt);
+  static DateTime  now();
+
+protected:
+  static long      offset;
+};
+
+#endif
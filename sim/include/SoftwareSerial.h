@@ -0,0 +1,46 @@
+/*
+ * Host simulation - SoftwareSerial stand-in
+ *
+ * Connected to the simulated YX5300 MP3 module. Transmitting blocks for one
+ * byte time per byte with interrupts disabled; received bytes land in a
+ * 64 byte buffer as they arrive on the virtual clock.
+ *
+ */
+
+#ifndef SIM_SOFTWARESERIAL_H
+#define SIM_SOFTWARESERIAL_H
+
+#include <Arduino.h>
+
+#define _SS_MAX_RX_BUFF 64
+
+class SoftwareSerial : public Stream {
+public:
+  SoftwareSerial(uint8_t receivePin, uint8_t transmitPin, bool inverse_logic = false);
+
+  void   begin(long speed);
+  void   end() {}
+  bool   listen() { return true; }
+  bool   isListening() { return true; }
+  bool   overflow();
+
+  int    available();
+  int    read();
+  int    peek();
+  size_t write(uint8_t b);
+  using  Print::write;
+
+  operator bool() { return true; }
+
+  /* Simulation: a byte arrived on the RX pin */
+  void   receive(uint8_t b);
+
+private:
+  long    baud;
+  uint8_t rxBuffer[_SS_MAX_RX_BUFF];
+  uint8_t rxHead;
+  uint8_t rxTail;
+  bool    rxOverflow;
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * Host simulation - Wire (TwoWire) stand-in
+ *
+ * Transactions are routed to the simulated I2C devices on the bus; only the
+ * DS1307 at address 0x68 is present.
+ *
+ */
+
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 32
+
+class TwoWire : public Stream {
+public:
+  void    begin();
+  void    beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+
+  size_t  write(uint8_t b);
+  size_t  write(const uint8_t *data, size_t quantity);
+  int     available();
+  int     read();
+  int     peek();
+
+  using   Print::write;
+
+private:
+  uint8_t txAddress;
+  uint8_t txBuffer[BUFFER_LENGTH];
+  uint8_t txLength;
+  uint8_t rxBuffer[BUFFER_LENGTH];
+  uint8_t rxIndex;
+  uint8_t rxLength;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * Host simulation - avr/pgmspace.h stand-in
+ *
+ * Flash and SRAM share one address space on the host, so the PROGMEM
+ * accessors are plain reads.
+ *
+ */
+
+#ifndef SIM_PGMSPACE_H
+#define SIM_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P                     const char *
+#define PSTR(s)                   (s)
+
+#define pgm_read_byte(addr)       (*(const uint8_t  *)(addr))
+#define pgm_read_word(addr)       (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)      (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr)        (*(void * const *)(addr))
+
+#define memcpy_P(dest, src, n)    memcpy((dest), (src), (n))
+#define strlen_P(s)               strlen(s)
+
+#endif
@@ -0,0 +1,18 @@
+/*
+ * Host simulation - avr/sleep.h stand-in
+ *
+ * Only idle mode; sleep_mode() lets simulated time pass until the next
+ * interrupt (see sim.h).
+ *
+ */
+
+#ifndef SIM_SLEEP_H
+#define SIM_SLEEP_H
+
+#define SLEEP_MODE_IDLE           0
+
+#define set_sleep_mode(mode)
+
+void sleep_mode();
+
+#endif
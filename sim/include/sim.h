@@ -0,0 +1,96 @@
+/*
+ * Host simulation - control interface
+ *
+ * The simulation keeps one virtual clock in microseconds. Everything the sketch
+ * does that takes time on a Nano is charged against that clock:
+ *    delay()                   -- lets the requested time pass
+ *    millis() / micros()       -- one microsecond per call, so busy-waits make progress
+ *    FastLED.show()            -- 30 us per LED + 50 us latch, with interrupts disabled
+ *    SoftwareSerial.write()    -- one byte time at the configured baud rate, interrupts disabled
+ *    EEPROM.write()            -- 3.3 ms erase/write stall
+ *    Wire transactions         -- 100 kHz I2C byte times
+ *
+ * Devices (DS1307, YX5300 MP3 module) are modelled as event sources on the same
+ * clock. Bytes the MP3 module sends while interrupts are disabled are garbled,
+ * just like SoftwareSerial reception on the real board.
+ *
+ * The counters in sim::stats are the basis for the performance checks.
+ *
+ */
+
+#ifndef SIM_SIM_H
+#define SIM_SIM_H
+
+#include <stdint.h>
+#include <functional>
+
+namespace sim {
+
+struct Stats {
+  uint64_t loops;                 // loop() passes
+  uint64_t frames;                // FastLED.show() / showColor() calls
+  uint64_t irq_off_us;            // Time spent with interrupts disabled
+  uint64_t sleep_us;              // Time spent asleep in sleep_mode()
+  uint64_t pin_interrupts;        // External interrupt handlers run
+
+  uint64_t mp3_tx_bytes;          // Bytes sent to the MP3 module
+  uint64_t mp3_rx_bytes;          // Bytes received from the MP3 module
+  uint64_t mp3_rx_garbled;        // Bytes that arrived while interrupts were disabled
+  uint64_t mp3_rx_overflow;       // Bytes dropped because the SoftwareSerial buffer was full
+  uint64_t mp3_commands;          // Complete command frames decoded by the module
+  uint64_t mp3_tx_early;          // Command frames started within 20 ms of the end of the previous one
+  uint64_t mp3_samples;           // Samples started by the module
+  uint64_t mp3_samples_cut;       // Samples stopped before their end by the next play command
+  uint64_t mp3_word_gaps;         // Silences of less than a second between two samples; within a sentence
+  uint64_t mp3_word_gap_us;       // Their total
+  uint64_t mp3_word_gap_us_max;
+  uint64_t mp3_sentences;         // Samples started after more than a second of silence
+  uint64_t mp3_sentence_delay_us; // Their total delay from the start of the RTC minute
+  uint64_t mp3_sentence_delay_us_max;
+  uint64_t mp3_awake_us;          // Time the module spent awake (amplifier on)
+
+  uint64_t serial_tx_bytes;       // Bytes printed on the USB serial port
+  uint64_t eeprom_writes;         // EEPROM cell writes
+  uint64_t i2c_transactions;      // Wire transmissions and requests
+
+  uint64_t heap_bytes;            // Sketch heap in use; malloc() / new by the sketch and the buffers of String objects
+  uint64_t heap_peak;             // The most heap the sketch ever had in use
+};
+
+extern Stats stats;
+
+/* Virtual clock */
+uint64_t now_us();
+void     advance_us(uint64_t us);                 // Let time pass with interrupts enabled
+void     irq_off_us(uint64_t us);                 // Busy with interrupts disabled
+void     at_us(uint64_t when, std::function<void()> event);
+bool     irq_disabled();
+void     steal_us(uint64_t us);                   // Interrupt handler time taken from the foreground
+void     mcu_ppm(int32_t ppm);                    // millis() / micros() run this many ppm fast (negative: slow)
+
+/* Pins */
+void     pin_edge(uint8_t pin, int edge);         // A RISING or FALLING edge on an input; runs its interrupt handler
+
+/* USB serial */
+void     serial_echo(bool enable);                // Copy sketch output to stdout
+void     serial_inject(const char *text);         // Queue bytes for Serial.read()
+
+/* DS1307 */
+void     rtc_set(uint32_t unixtime, bool running);
+uint32_t rtc_unixtime();
+int64_t  rtc_second_us(uint32_t unixtime);        // Virtual time at which that RTC second starts
+void     rtc_connected(bool connected);           // Simulate a broken I2C connection
+void     rtc_sqw_connected(bool connected);       // Whether SQW/OUT is wired to D3
+
+/* EEPROM */
+uint8_t  eeprom_peek(int address);
+void     eeprom_poke(int address, uint8_t value);
+uint32_t eeprom_cell_writes(int address);
+
+/* YX5300 MP3 module */
+void     mp3_sample_ms(uint8_t folder, uint8_t file, uint16_t duration);
+uint64_t mp3_awake_us();                          // Time awake so far
+
+}
+
+#endif
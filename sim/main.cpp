@@ -0,0 +1,207 @@
+/*
+ * Host simulation - harness
+ *
+ * Runs setup() once and loop() for a number of simulated seconds, then prints
+ * the counters as key=value lines so runs can be compared by scripts.
+ *
+ * Usage: clock_sim [options]
+ *    --seconds N           -- Simulated run time after setup()  (default 60)
+ *    --start "Y-M-D h:m:s" -- DS1307 time at power on           (default 2017-10-29 11:59:30)
+ *    --dst 0|1             -- DST state stored in EEPROM        (default: erased)
+ *    --tz N                -- Time zone stored in EEPROM (tz.h) (default: erased)
+ *    --loop-cost US        -- Fixed cost of one loop() pass     (default 50)
+ *    --mcu-ppm N           -- The Nano's resonator runs N ppm fast; negative is slow (default 0)
+ *    --no-sqw              -- SQW/OUT of the DS1307 is not wired
+ *    --rtc-away S,N        -- The DS1307 doesn't answer from S seconds after setup() for N seconds (0: from power on);
+ *                             fail (exit 1) when the sketch didn't recover from it
+ *    --stored DRIFT,DST    -- A record with this drift (ppm) and DST state in the RAM of the DS1307 at power on;
+ *                             fail (exit 1) when the drift in use ends up more than 10 ppm from DRIFT (give the
+ *                             same --mcu-ppm) or the next boot wouldn't find the state the clock ended with
+ *    --announce-every N    -- Also say the time every N minutes; a soak test of the speech
+ *    --heap-flat           -- Fail (exit 1) when the heap high-water mark moved after setup()
+ *    --verbose             -- Echo the sketch's Serial output
+ *
+ */
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include <EEPROM.h>
+#include <sim.h>
+
+void setup();
+void loop();
+uint32_t sketch_epoch();
+void     sketch_announce_every(uint16_t minutes);
+void     sketch_store(int16_t drift, uint8_t dst);
+bool     sketch_store_survives();
+uint32_t sketch_recoveries();
+int16_t  sketch_drift();
+void     sketch_report();
+
+// The most written EEPROM cell; what wears out first
+static uint32_t eeprom_cell_writes_max() {
+  uint32_t most = 0;
+
+  for ( int a = 0; a <= E2END; a++ ) {
+    if ( sim::eeprom_cell_writes(a) > most ) { most = sim::eeprom_cell_writes(a); }
+  }
+  return most;
+}
+
+static void usage() {
+  fprintf(stderr, "usage: clock_sim [--seconds N] [--start \"YYYY-MM-DD hh:mm:ss\"] [--dst 0|1] [--tz N] [--loop-cost US] [--mcu-ppm N] [--no-sqw] [--rtc-away S,N] [--stored DRIFT,DST] [--announce-every N] [--heap-flat] [--verbose]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  uint32_t seconds   = 60;
+  uint32_t loop_cost = 50;
+  DateTime start(2017, 10, 29, 11, 59, 30);
+  uint32_t away_at   = 0;
+  uint32_t away_for  = 0;
+  uint16_t announce  = 0;
+  bool     heap_flat = false;
+  bool     stored    = false;
+  int      stored_drift, stored_dst;
+
+  for ( int i = 1; i < argc; i++ ) {
+    if ( !strcmp(argv[i], "--seconds") && i + 1 < argc ) {
+      seconds = strtoul(argv[++i], 0, 10);
+    } else if ( !strcmp(argv[i], "--start") && i + 1 < argc ) {
+      int y, mo, d, h, mi, s;
+      if ( sscanf(argv[++i], "%d-%d-%d %d:%d:%d", &y, &mo, &d, &h, &mi, &s) != 6 ) { usage(); }
+      start = DateTime(y, mo, d, h, mi, s);
+    } else if ( !strcmp(argv[i], "--dst") && i + 1 < argc ) {
+      sim::eeprom_poke(0, atoi(argv[++i]) ? 1 : 0);
+    } else if ( !strcmp(argv[i], "--tz") && i + 1 < argc ) {
+      sim::eeprom_poke(1, atoi(argv[++i]));
+    } else if ( !strcmp(argv[i], "--mcu-ppm") && i + 1 < argc ) {
+      sim::mcu_ppm(atoi(argv[++i]));
+    } else if ( !strcmp(argv[i], "--loop-cost") && i + 1 < argc ) {
+      loop_cost = strtoul(argv[++i], 0, 10);
+    } else if ( !strcmp(argv[i], "--no-sqw") ) {
+      sim::rtc_sqw_connected(false);
+    } else if ( !strcmp(argv[i], "--rtc-away") && i + 1 < argc ) {
+      if ( sscanf(argv[++i], "%u,%u", &away_at, &away_for) != 2 ) { usage(); }
+    } else if ( !strcmp(argv[i], "--stored") && i + 1 < argc ) {
+      if ( sscanf(argv[++i], "%d,%d", &stored_drift, &stored_dst) != 2 ) { usage(); }
+      stored = true;
+    } else if ( !strcmp(argv[i], "--announce-every") && i + 1 < argc ) {
+      announce = atoi(argv[++i]);
+    } else if ( !strcmp(argv[i], "--heap-flat") ) {
+      heap_flat = true;
+    } else if ( !strcmp(argv[i], "--verbose") ) {
+      sim::serial_echo(true);
+    } else {
+      usage();
+    }
+  }
+
+  sim::rtc_set(start.unixtime(), true);
+  if ( stored ) { sketch_store(stored_drift, stored_dst); }
+  if ( away_for && away_at == 0 ) { sim::rtc_connected(false); }
+
+  setup();
+  if ( announce ) { sketch_announce_every(announce); }
+
+  // Count loop() passes per simulated second
+  uint64_t setup_us   = sim::now_us();
+  uint64_t end_us     = setup_us + (uint64_t)seconds * 1000000;
+  uint64_t second_end = setup_us + 1000000;
+  uint64_t per_second = 0;
+  uint64_t min_loops  = ~0ULL;
+  uint64_t max_loops  = 0;
+  uint64_t loop_max   = 0;    // The longest loop() pass
+
+  if ( away_for ) {
+    if ( away_at ) {
+      sim::at_us(setup_us + (uint64_t)away_at * 1000000, []() { sim::rtc_connected(false); });
+    }
+    sim::at_us(setup_us + (uint64_t)(away_at + away_for) * 1000000, []() { sim::rtc_connected(true); });
+  }
+
+  sim::Stats at_setup = sim::stats;
+
+  // How far the shown second starts from the RTC's second; over the last half of the run
+  uint32_t shown      = sketch_epoch();
+  int64_t  error_max  = 0;
+  int64_t  error_last = 0;
+
+  while ( sim::now_us() < end_us ) {
+    uint64_t loop_start = sim::now_us();
+    loop();
+    if ( sim::now_us() - loop_start > loop_max ) { loop_max = sim::now_us() - loop_start; }
+    sim::advance_us(loop_cost);
+    sim::stats.loops++;
+    per_second++;
+
+    if ( sketch_epoch() != shown ) {
+      shown      = sketch_epoch();
+      error_last = (int64_t)sim::now_us() - sim::rtc_second_us(shown);
+
+      if ( sim::now_us() >= setup_us + ( end_us - setup_us ) / 2 && llabs(error_last) > error_max ) {
+        error_max = llabs(error_last);
+      }
+    }
+
+    while ( sim::now_us() >= second_end ) {
+      if ( per_second < min_loops ) { min_loops = per_second; }
+      if ( per_second > max_loops ) { max_loops = per_second; }
+      per_second  = 0;
+      second_end += 1000000;
+    }
+  }
+
+  const sim::Stats &s = sim::stats;
+  DateTime rtc(sim::rtc_unixtime());
+
+  printf("setup_ms=%llu\n",           (unsigned long long)(setup_us / 1000));
+  printf("seconds=%u\n",              seconds);
+  printf("rtc=%04d-%02d-%02d %02d:%02d:%02d\n", rtc.year(), rtc.month(), rtc.day(), rtc.hour(), rtc.minute(), rtc.second());
+  printf("loops=%llu\n",              (unsigned long long)s.loops);
+  printf("loops_per_second_avg=%llu\n", (unsigned long long)(seconds ? s.loops / seconds : 0));
+  printf("loops_per_second_min=%llu\n", (unsigned long long)(min_loops == ~0ULL ? 0 : min_loops));
+  printf("loops_per_second_max=%llu\n", (unsigned long long)max_loops);
+  printf("loop_ms_max=%llu\n",        (unsigned long long)(loop_max / 1000));
+  printf("frames=%llu\n",             (unsigned long long)(s.frames - at_setup.frames));
+  printf("irq_off_ms=%llu\n",         (unsigned long long)((s.irq_off_us - at_setup.irq_off_us) / 1000));
+  printf("sleep_ms=%llu\n",           (unsigned long long)((s.sleep_us - at_setup.sleep_us) / 1000));
+  printf("pin_interrupts=%llu\n",     (unsigned long long)s.pin_interrupts);
+  printf("mp3_commands=%llu\n",       (unsigned long long)s.mp3_commands);
+  printf("mp3_samples=%llu\n",        (unsigned long long)s.mp3_samples);
+  printf("mp3_samples_cut=%llu\n",    (unsigned long long)s.mp3_samples_cut);
+  printf("mp3_word_gap_ms_avg=%llu\n", (unsigned long long)(s.mp3_word_gaps ? s.mp3_word_gap_us / s.mp3_word_gaps / 1000 : 0));
+  printf("mp3_word_gap_ms_max=%llu\n", (unsigned long long)(s.mp3_word_gap_us_max / 1000));
+  printf("mp3_sentence_delay_ms_avg=%llu\n", (unsigned long long)(s.mp3_sentences ? s.mp3_sentence_delay_us / s.mp3_sentences / 1000 : 0));
+  printf("mp3_sentence_delay_ms_max=%llu\n", (unsigned long long)(s.mp3_sentence_delay_us_max / 1000));
+  printf("mp3_awake_s=%llu\n",        (unsigned long long)((sim::mp3_awake_us() - at_setup.mp3_awake_us) / 1000000));
+  printf("mp3_tx_early=%llu\n",       (unsigned long long)s.mp3_tx_early);
+  printf("mp3_tx_bytes=%llu\n",       (unsigned long long)s.mp3_tx_bytes);
+  printf("mp3_rx_bytes=%llu\n",       (unsigned long long)s.mp3_rx_bytes);
+  printf("mp3_rx_garbled=%llu\n",     (unsigned long long)s.mp3_rx_garbled);
+  printf("mp3_rx_overflow=%llu\n",    (unsigned long long)s.mp3_rx_overflow);
+  printf("serial_tx_bytes=%llu\n",    (unsigned long long)s.serial_tx_bytes);
+  printf("itc_error_ms_max=%lld\n",   (long long)(error_max / 1000));
+  printf("itc_error_ms_last=%lld\n",  (long long)(error_last / 1000));
+  printf("eeprom_writes=%llu\n",      (unsigned long long)s.eeprom_writes);
+  printf("eeprom_cell_writes_max=%u\n", eeprom_cell_writes_max());
+  printf("i2c_transactions=%llu\n",   (unsigned long long)s.i2c_transactions);
+  printf("heap_peak_bytes=%llu\n",    (unsigned long long)s.heap_peak);
+  printf("heap_peak_growth=%llu\n",   (unsigned long long)(s.heap_peak - at_setup.heap_peak));
+  sketch_report();
+
+  if ( away_for && sketch_recoveries() == 0 ) {
+    fprintf(stderr, "the RTC outage went unnoticed\n");
+    return 1;
+  }
+  if ( stored && ( abs(sketch_drift() - stored_drift) > 10 || !sketch_store_survives() ) ) {
+    fprintf(stderr, "the stored drift and DST state didn't survive\n");
+    return 1;
+  }
+  if ( heap_flat && s.heap_peak != at_setup.heap_peak ) {
+    fprintf(stderr, "heap high-water mark moved from %llu to %llu bytes after setup()\n",
+            (unsigned long long)at_setup.heap_peak, (unsigned long long)s.heap_peak);
+    return 1;
+  }
+  return 0;
+}
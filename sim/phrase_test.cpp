@@ -0,0 +1,96 @@
+/*
+ * Host simulation - phrase table test
+ *
+ * Checks every entry of the phrase table (phrases.h, generated by phrases.py) against the way Speech::Time()
+ * used to build the sentence, for all 720 times on the dial plus hour 12, which has to say the same as hour 0.
+ *
+ * Usage: phrase_test      -- exits 1 on the first mismatch
+ *
+ */
+
+#include <Arduino.h>
+
+#include "../arbiter.h"
+#include "../speech.h"
+
+// Speech::Time() before the phrase table, without the printing
+static uint8_t reference(uint8_t hour, uint8_t minute, uint8_t *Sentence) {
+  uint8_t afterhour   = hour;
+  uint8_t beforehour  = hour;
+  uint8_t CurrentWord = 0;
+
+  Sentence[CurrentWord++] = HET_IS_NU;
+
+  afterhour  = ( hour == 0 ) ? 12 : hour;
+  beforehour = ( (hour % 12 ) == 0 ) ? 1 : hour + 1;
+
+  if ( minute % 15 == 0 ) {
+    switch ( int ( minute / 15 ) ) {
+      case 0:
+        Sentence[CurrentWord++] = afterhour;
+        Sentence[CurrentWord++] = UUR;
+        break;
+      case 1:
+        Sentence[CurrentWord++] = KWART;
+        Sentence[CurrentWord++] = OVER;
+        Sentence[CurrentWord++] = afterhour;
+        break;
+      case 2:
+        Sentence[CurrentWord++] = HALF;
+        Sentence[CurrentWord++] = beforehour;
+        break;
+      case 3:
+        Sentence[CurrentWord++] = KWART;
+        Sentence[CurrentWord++] = VOOR;
+        Sentence[CurrentWord++] = beforehour;
+        break;
+    }
+  } else {
+    switch ( int ( minute / 15 ) ) {
+      case 0:
+        Sentence[CurrentWord++] = minute;
+        Sentence[CurrentWord++] = OVER;
+        Sentence[CurrentWord++] = afterhour;
+        break;
+      case 1:
+        Sentence[CurrentWord++] = 30 - minute;
+        Sentence[CurrentWord++] = VOOR;
+        Sentence[CurrentWord++] = HALF;
+        Sentence[CurrentWord++] = beforehour;
+        break;
+      case 2:
+        Sentence[CurrentWord++] = minute - 30;
+        Sentence[CurrentWord++] = OVER;
+        Sentence[CurrentWord++] = HALF;
+        Sentence[CurrentWord++] = beforehour;
+        break;
+      case 3:
+        Sentence[CurrentWord++] = 60 - minute;
+        Sentence[CurrentWord++] = VOOR;
+        Sentence[CurrentWord++] = beforehour;
+        break;
+    }
+  }
+  return CurrentWord;
+}
+
+int main() {
+  uint32_t checked = 0;
+
+  for ( uint8_t hour = 0; hour <= 12; hour++ ) {
+    for ( uint8_t minute = 0; minute < 60; minute++ ) {
+      uint8_t expected[15] = {0};
+      uint8_t words[15]    = {0};
+      uint8_t count        = reference(hour, minute, expected);
+
+      if ( Mp3Speech.Phrase(hour, minute, words) != count || memcmp(words, expected, sizeof(words)) ) {
+        printf("phrase mismatch at %d:%02d\n", hour, minute);
+        return 1;
+      }
+      checked++;
+    }
+  }
+
+  printf("phrases_checked=%u\n", checked);
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Host simulation - the sketch
+ *
+ * Compiles Clock_v8.ino and its headers unchanged. The Arduino builder adds
+ * prototypes for the functions defined in the .ino; they are listed here.
+ *
+ */
+
+#include <Arduino.h>
+
+void setup();
+void loop();
+void SerialDataProvided();
+void PrepareHour();
+void HourChanged();
+void QuarterChanged();
+void FiveMinutesChanged();
+void MinuteChanged();
+void DSTChanged();
+
+#include "../Clock_v8.ino"
+
+// The second the sketch shows; read by the harness
+uint32_t sketch_epoch() {
+  return Current.tick.epoch;
+}
+
+// Have the sketch say the time every N minutes on top of its own announcements
+void sketch_announce_every(uint16_t minutes) {
+  Schedule.every(minutes, MinuteChanged);
+}
+
+// A clock that ran before: its drift and DST state in the RAM of the RTC, some writes into the ring
+void sketch_store(int16_t drift, uint8_t dst) {
+  Persisted.init();
+  for ( uint8_t i = 0; i < 8; i++ ) {
+    Persisted.setDrift(drift + 1);
+    Persisted.setDrift(drift);
+  }
+  Persisted.setDST(dst);
+}
+
+// Times the sketch got the RTC back after a fault
+uint32_t sketch_recoveries() {
+  return Current.rtcRecoveries;
+}
+
+// The drift correction the ITC runs with
+int16_t sketch_drift() {
+  return Current.driftPpm;
+}
+
+// Whether the next boot finds the state the clock runs with
+bool sketch_store_survives() {
+  int16_t drift = Persisted.drift();
+  uint8_t dst   = Persisted.dst();
+
+  Persisted.init();
+  return Persisted.drift() == drift && Persisted.dst() == dst
+      && abs(Current.driftPpm - drift) < DRIFTSTORESTEP && dst == Current.DST;
+}
+
+// The sketch's own counters, in the harness' key=value format
+void sketch_report() {
+  printf("rtc_faults=%lu\n",          Current.rtcFaults);
+  printf("i2c_errors=%lu\n",          Current.i2cErrors);
+  printf("rtc_recoveries=%lu\n",      Current.rtcRecoveries);
+  printf("recovery_ms_max=%lu\n",     Current.recoveryMillisMax);
+  printf("itc_drift_ppm=%d\n",        Current.driftPpm);
+  printf("stored_drift_ppm=%d\n",     Persisted.drift());
+  printf("stored_dst=%d\n",           Persisted.dst());
+  printf("mp3_answers=%lu\n",         Mp3Speech.rxAnswers);
+  printf("mp3_answer_errors=%lu\n",   Mp3Speech.rxErrors);
+  printf("mp3_play_timeouts=%lu\n",   Mp3Speech.playTimeouts);
+  printf("mp3_play_ahead=%lu\n",      Mp3Speech.playAhead);
+  printf("mp3_wake_ups=%lu\n",        Mp3Speech.wakeUps);
+  printf("led_frames_deferred=%lu\n", LedArbiter.framesDeferred);
+  printf("led_frames_forced=%lu\n",   LedArbiter.framesForced);
+}
@@ -0,0 +1,125 @@
+/*
+ * Host simulation - speech over the loopback transport
+ *
+ * Runs a Speech<Mp3Loopback> (transport.h) on the virtual clock: checks the command frames it sends, that a
+ * buffered transport gets a whole frame per update() and nothing while it has less room than a frame, and that
+ * answers split over several updates, with stray bytes in front or after a truncated answer, are taken.
+ *
+ * Usage: speech_test      -- exits 1 on the first failure
+ *
+ */
+
+#include <Arduino.h>
+#include <sim.h>
+
+#include "../arbiter.h"
+#include "../speech.h"
+
+static Speech<Mp3Loopback> speech;
+static uint32_t            checks = 0;
+
+static void check(bool ok, const char *what) {
+  checks++;
+  if ( !ok ) {
+    printf("speech_test failed: %s\n", what);
+    exit(1);
+  }
+}
+
+// Run update() for a while; the loop of the sketch
+static void run_ms(uint32_t ms) {
+  for ( uint32_t i = 0; i < ms; i++ ) {
+    speech.update();
+    sim::advance_us(1000);
+  }
+}
+
+// The next frame sent; false when there is none
+static bool sent(uint8_t &command, uint16_t &data) {
+  uint8_t frame[8];
+
+  for ( uint8_t i = 0; i < sizeof(frame); i++ ) {
+    int b = speech.Port.sent();
+    if ( b < 0 ) { return false; }
+    frame[i] = b;
+  }
+  check(frame[0] == 0x7E && frame[1] == 0xFF && frame[2] == 0x06 && frame[7] == 0xEF, "frame layout");
+  command = frame[3];
+  data    = ( frame[5] << 8 ) | frame[6];
+  return true;
+}
+
+// Wait for the next frame
+static void expect(uint8_t command, uint16_t data, const char *what) {
+  uint8_t  c;
+  uint16_t d;
+
+  for ( uint32_t ms = 0; ms < 1000; ms++ ) {
+    if ( sent(c, d) ) {
+      check(c == command && d == data, what);
+      return;
+    }
+    run_ms(1);
+  }
+  check(false, what);
+}
+
+static void answer(const uint8_t *bytes, uint8_t length) {
+  for ( uint8_t i = 0; i < length; i++ ) { speech.Port.inject(bytes[i]); }
+}
+
+int main() {
+  uint8_t  c;
+  uint16_t d;
+
+  speech.init();
+  speech.update();
+  check(!sent(c, d), "nothing before the player started up");
+
+  expect(CMD_SEL_DEV, DEV_TF, "select the memory card");
+  expect(CMD_SLEEP_MODE, 0, "sleep when there's nothing to say");
+
+  // A buffered transport short of room gets no part of a frame; then the whole frame in one update()
+  run_ms(MP3COMMANDGAP);
+  speech.Port.limit(7);
+  speech.Time(1, 30);
+  run_ms(10);
+  check(speech.Port.sent() < 0, "no part of a frame without room for all of it");
+  speech.Port.limit(8);
+  speech.update();
+  check(sent(c, d) && c == CMD_WAKE_UP, "whole frame in one update()");
+  expect(CMD_PLAY_FOLDER_FILE, FOLDER * 256 + HET_IS_NU, "het is nu");
+  check(!sent(c, d), "next word waits for the end of this one");
+
+  // The end of the word, split over two updates with a stray byte in front
+  const uint8_t finished[] = { 0x12, 0x7E, 0xFF, 0x06, 0x3D, 0x00, 0x00, HET_IS_NU, 0xFE, 0xAD, 0xEF };
+  run_ms(200);
+  answer(finished, 6);
+  run_ms(1);
+  check(!sent(c, d), "half an answer does nothing");
+  answer(finished + 6, sizeof(finished) - 6);
+  expect(CMD_PLAY_FOLDER_FILE, FOLDER * 256 + HALF, "half");
+
+  check(speech.rxAnswers == 1, "one answer taken");
+
+  // A truncated answer runs into the next one: its 0x7E lands where the feedback should be
+  const uint8_t truncated[] = { 0x7E, 0xFF, 0x06, 0x3D };
+  const uint8_t halfDone[]  = { 0x7E, 0xFF, 0x06, 0x3D, 0x00, 0x00, HALF, 0xFE, 0xAF, 0xEF };
+  run_ms(200);
+  answer(truncated, sizeof(truncated));
+  answer(halfDone, sizeof(halfDone));
+  expect(CMD_PLAY_FOLDER_FILE, FOLDER * 256 + TWEE, "the answer after a truncated one is taken");
+  check(speech.rxAnswers == 2, "two answers taken");
+
+  // The rest of an answer never comes; after MP3RXTIMEOUT the next one starts over, even where data could be 0x7E
+  const uint8_t tweeDone[]  = { 0x7E, 0xFF, 0x06, 0x3D, 0x00, 0x00, TWEE, 0xFE, 0xBC, 0xEF };
+  run_ms(200);
+  answer(tweeDone, 5);
+  run_ms(MP3RXTIMEOUT + 2);
+  answer(tweeDone, sizeof(tweeDone));
+  run_ms(1);
+  check(speech.rxAnswers == 3, "an answer after a quiet line is taken");
+
+  printf("speech_checks=%u\n", checks);
+  return 0;
+}
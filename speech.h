@@ -1,5 +1,5 @@
 /*
- * Speech Library  (Uses the SoftwareSerial library)
+ * Speech Library  (Uses the SoftwareSerial library or the hardware UART; see transport.h)
  * 
  * Manages several features for addressing the MP3 player:
  *  - Determining the words forming the Time
@@ -7,27 +7,64 @@
  *  - Determining when playing a sample has come to an end
  *  - Handling the power management of the MP3 player
  * 
+ * Commands don't wait for the MP3 player: sendCommand() puts them in a small ring buffer and update() clocks
+ * them out: a whole frame per call to a buffered transport, a byte per call to SoftwareSerial. A frame only starts when the player is ready for it: MP3STARTUPTIME after power
+ * up and, after every command, the gap that command needs (commandGap()). So the loop never waits for the
+ * player and the leds keep animating while the clock talks.
+ * 
+ * Answers are taken in the other way around: receive() gets one byte at a time from a small state machine that
+ * starts an answer on 0x7E, checks the length, the checksum and the closing 0xEF and hands a complete answer to
+ * answer() as a command and its data. A byte that doesn't fit drops the answer and the receiver starts over on the
+ * next 0x7E; a 0x7E where an answer can't hold one (the command, the feedback or the first checksum byte) starts
+ * the next answer right away and an answer whose line was seen quiet for MP3RXTIMEOUT after its last byte is
+ * dropped, so the rest of a truncated answer can't take the next one with it. Answers split over several calls,
+ * answers stuck together and stray bytes are all handled without a buffer or the heap.
+ * 
+ * Words follow each other without waiting for the player: the duration index holds how long each sample of FOLDER
+ * took the first times it played to the end (the player can't be asked). Once a word's duration is known, the next
+ * word is sent MP3PLAYLEAD before the predicted end; until then, and for the last word, the player's "finished"
+ * answer starts the next one.
+ * 
+ * The player (and its amplifier) sleeps unless there's something to say. After a sentence it stays awake for
+ * MP3IDLETIMEOUT so sentences close together don't wake it every time; prepare() wakes it ahead of an announcement
+ * that is known to come (the hour) and keeps it awake for up to MP3PREWAKETIME, so the first word goes out at once.
+ * 
+ * Bytes from the player get garbled when a led push has the interrupts off (see arbiter.h). Speech tells LedArbiter
+ * when they come: MP3ACKWINDOW after every command, while an answer is partly in and MP3ENDWINDOW around the
+ * predicted end of a sample.
+ * 
+ * The speech layer keeps no String and nothing else on the heap; what it does keep is checked against
+ * MP3SRAMBUDGET when compiling. A word the player never reports finished counts as finished after MP3PLAYTIMEOUT.
+ * 
  * Functions
  *    init()          -- Initialize the MP3 player
  *    update()        -- Since this library is continually processed we need to determine if time has come to play the next sample by checking whther the status is Finished playing
  *    
  *    Time()          -- Translates time to the call of an MP3
+ *    Phrase()        -- The words for a time, from the phrase table (phrases.h)
  *    WordCount()     -- Determine the wordcount of a sentence
  *    clearSentence() -- Empty the sentence (No more talking)
  *    NextWord()      -- Jump to the next word
  *    
  *    playSample()    -- Play a specific MP3 sample
+ *    finished()      -- The player reports the end of a sample; learn how long it took
+ *    untilEnd()      -- Milliseconds until the sample playing ends according to the duration index
  *    mp3_status()    -- Process the serial buffer and handle the statusses provided
  *    getMp3Status()  -- Request the status of the MP3 player (Acts weird; not using it)
  *    
  *    wake()          -- Change the powerstate of the MP3 player to active
  *    sleep()         -- Change the powerstate of the MP3 player to inactive
+ *    prepare()       -- Wake the MP3 player ahead of an announcement
+ *    stayAwake()     -- Keep the MP3 player awake for a while
  *    reset()         -- Reset the MP3 player
  *    
- *    sendCommand()   -- Send a serial command to the MP3 player
- *    sanswer()       -- Receive a pending response from the MP3 player
+ *    sendCommand()   -- Queue a serial command for the MP3 player
+ *    transmit()      -- Send the next frame or byte of the queued commands when the MP3 player is ready for it
+ *    commandGap()    -- The time the MP3 player needs after a command before it takes the next one
+ *    receive()       -- Take the next byte of an answer from the MP3 player; true when the answer is complete
+ *    answer()        -- Handle a complete answer from the MP3 player
+ *    resync()        -- Drop the answer being received and wait for the next one
  *    printHex()      -- Helper function for showing which Hex address is called to the MP3 player
- *    sbyte2hex()     -- Helper function to translate bytes to Hex
  *    
  *   Source of some of the code below:  https://github.com/cefaloide/ArduinoSerialMP3Player/blob/master/ArduinoSerialMP3Player/ArduinoSerialMP3Player.ino
  *                                      http://www.dx.com/p/uart-control-serial-mp3-music-player-module-for-arduino-avr-arm-pic-blue-silver-342439#.VfHyobPh5z0
@@ -66,9 +103,9 @@
 #define VOOR        19
 #define UUR         20
 
-SoftwareSerial Mp3Serial(MP3_RX, MP3_TX);
+#include "./phrases.h"
 
-String mp3Answer;           // Answer from the MP3.
+#include "./transport.h"
 
 /************ Command byte **************************/
 #define CMD_NEXT_SONG         0X01  // Play next song.
@@ -107,12 +144,63 @@ String mp3Answer;           // Answer from the MP3.
 /************ Options **************************/
 #define DEV_TF 0X02
 
-static int8_t Send_buf[8] = {0}; // Buffer for Send commands.  // BETTER LOCALLY
-static uint8_t ansbuf[10] = {0}; // Buffer for the answers.    // BETTER LOCALLY
+/************ Frame ****************************/
+#define MP3_START             0x7E
+#define MP3_VERSION           0xFF
+#define MP3_LENGTH            0x06  // The bytes from the version up to the data
+#define MP3_END               0xEF
+
+/************ Receive states *******************/
+// The position in an answer: 7E FF 06 CMD FEEDBACK DATAH DATAL [CHECKH CHECKL] EF
+#define RX_START                 0  // Waiting for the start of an answer
+#define RX_VERSION               1
+#define RX_LENGTH                2
+#define RX_COMMAND               3
+#define RX_FEEDBACK              4
+#define RX_DATAH                 5
+#define RX_DATAL                 6
+#define RX_CHECKH                7  // Or the end of an answer without a checksum
+#define RX_CHECKL                8
+#define RX_END                   9
+
+/************ Transmit queue *******************/
+#define MP3QUEUESIZE          8  // Commands waiting to be sent; a power of two
+#define MP3STARTUPTIME      500  // Milliseconds after power up before the first command
+#define MP3COMMANDGAP        20  // Milliseconds between two commands
+#define MP3WAKEGAP           70  // Milliseconds after waking up
+#define MP3MOUNTGAP         500  // Milliseconds after selecting the memory card or a reset
+#define MP3PLAYTIMEOUT     3000  // Milliseconds after which a word counts as finished when the player didn't say so
+
+/************ Power ****************************/
+#define MP3IDLETIMEOUT    10000  // Milliseconds the player stays awake after the last word
+#define MP3PREWAKETIME    90000  // Milliseconds prepare() keeps the player awake when nothing is said
+
+/************ Duration index *******************/
+#define MP3SAMPLES           21  // Samples of FOLDER in the index (0 .. UUR)
+#define MP3SAMPLEUNIT        10  // Milliseconds per step; a duration is kept in a byte
+#define MP3PLAYLEAD          30  // Milliseconds before the predicted end of a word the next one is sent
+#define MP3MINSAMPLE        100  // A finished answer sooner after the start is the one of the word before
+#define MP3NOEND    0x7FFFFFFFL  // untilEnd() when the duration of the sample isn't known
+
+/************ Answer windows *******************/
+#define MP3ACKWINDOW         40  // Milliseconds after a command in which its answer comes in
+#define MP3ENDWINDOW         20  // Milliseconds around the predicted end of a sample in which it reports finished
+#define MP3BYTEWINDOW         3  // Milliseconds until the next byte of an answer that started
+#define MP3RXTIMEOUT          5  // Milliseconds without a byte after which an answer that started is dropped
+
+/************ Memory ***************************/
+#define MP3SRAMBUDGET       192  // Bytes of SRAM Speech may take besides its transport (about 140 on the Nano); no heap
+
+struct Mp3Command {
+  uint8_t  command;
+  uint16_t data;
+};
 
+template <class Transport>
 class Speech 
 {
 private:
+  int8_t  Send_buf[8]   = {0};          // The frame being sent
   uint8_t Sentence[15];
   uint8_t Word          = 0;            // Initialize to the first word
   uint8_t Words         = 0;            // Initialize the wordcount
@@ -122,19 +210,44 @@ private:
   bool    Error         = false;
   bool    Ok            = true;
   bool    Sleeping      = false;
-  uint16_t LastWordTime;
+  unsigned long AwakeUntil = 0;         // millis() up to which the player stays awake with nothing to say
+  unsigned long PlayStarted;            // millis() when the word was queued; then when it was sent
+  bool    PlaySent      = false;        // The command for the word has gone out
+  uint8_t PlayingSample = 0;
+  uint8_t SampleTime[MP3SAMPLES] = {0}; // The duration index; the longest each sample took in MP3SAMPLEUNIT, 0: unknown
   
-  String  PlayingNumber, FileCount, FolderFileCount, FolderCount;
+  uint16_t PlayingNumber, FileCount, FolderFileCount, FolderCount;
+
+  Mp3Command    txQueue[MP3QUEUESIZE];
+  uint8_t       txHead        = 0;    // The command being sent
+  uint8_t       txTail        = 0;    // Where the next command is queued
+  uint8_t       txByte        = 0;    // The next byte of Send_buf; 0 when no frame is being sent
+  unsigned long txReady       = 0;    // millis() from which the next frame may start
+
+  uint8_t       rxState       = RX_START;
+  uint8_t       rxCommand;
+  uint16_t      rxData;
+  uint16_t      rxCheck;
+  uint16_t      rxSum;                // Of the bytes from the version up to the data
+  uint16_t      rxLast;               // millis() when the last bytes were taken; the low bits do for a few ms
+  uint16_t      rxQuiet;              // millis() when no byte had come in since, halfway an answer
     
 public:   
+  Transport     Port;                 // The connection to the MP3 player
+
+  unsigned long txDropped     = 0;    // Commands that didn't fit in the queue
+  unsigned long rxAnswers     = 0;    // Complete answers received
+  unsigned long rxErrors      = 0;    // Answers dropped for a bad length, checksum or end
+  unsigned long playTimeouts  = 0;    // Words that never reported finished
+  unsigned long playAhead     = 0;    // Words sent ahead of the end of the word before
+  unsigned long wakeUps       = 0;    // Times the player was woken up
 
 void init() {
   Serial.println(F("Initializing MP3 player..."));  
   
-  Mp3Serial.begin(9600);
-  delay(500);
+  Port.begin(9600);
+  txReady = millis() + MP3STARTUPTIME;
   sendCommand(CMD_SEL_DEV, DEV_TF);
-  delay(500);
   
   clearSentence();
 }
@@ -150,134 +263,131 @@ uint8_t WordCount() {
     }
   }
   
-//  Serial.println("A Sentence has been loaded of " + String(Count) + " words" + " Playing: " + String(Playing) + " Sleeping: " + String(Sleeping));  
+//  Serial.print(F("A Sentence has been loaded of ")); Serial.print(Count); Serial.println(F(" words"));
   return Count;
 }
 
 void wake(){
   // Serial.println(F("Waking up..."));
   Sleeping  = false;
+  wakeUps++;
   sendCommand(CMD_WAKE_UP, 0x00);
-  
-  if ( Mp3Serial.available() ) {
-      mp3_status();                // Process status changes
-  }
 }
 
 void sleep() {
   //Serial.println(F("Entering sleep mode..."));
   Sleeping  = true;
   sendCommand(CMD_SLEEP_MODE, 0x00);
-  
-  if ( Mp3Serial.available() ) {
-      mp3_status();                // Process status changes
+}
+
+// An announcement follows within MP3PREWAKETIME
+void prepare() {
+  if ( Sleeping ) {
+    wake();
   }
+  stayAwake(MP3PREWAKETIME);
+}
+
+void stayAwake(unsigned long milliseconds) {
+  AwakeUntil = millis() + milliseconds;
 }
 
 void getMp3Status() {
   Serial.println(F("Requesting MP3 status..."));
-  sendCommand(CMD_QUERY_STATUS, 0x00);
-
-  if ( Mp3Serial.available() ) {
-      mp3_status();                // Process status changes
-  }
-  delay(500);  
+  sendCommand(CMD_QUERY_STATUS, 0x00);   // The answer is handled by update()
 }
 
 void reset() {
   sendCommand(CMD_RESET, 0x00);
-  
-  if ( Mp3Serial.available() ) {
-      mp3_status();                // Process status changes
-  }
 }
 
 void mp3_status() {
-    delay(50);
-    // Process the buffer
-    while (Mp3Serial.available())
-    {
-      sanswer();   // Fill the answer buffer...
-      switch (ansbuf[3]) {
-        case 0x3A:
-          MemoryCard  = true;
-          Serial.println(F("Memory card inserted"));
-          break;
-    
-        case 0x3B:
-          MemoryCard  = false;
-          Serial.println(F("Memory card removed"));
-          break;      
-        
-        case 0x3D:
-          //Serial.println("Finished playing number: " + String(ansbuf[6], DEC));
-          Playing     = false;
-          break;
-          
-        case 0x00:
-          // There are some serialisation issues here...
-          // Appearantly the status response can come in earlier than expected.
-          //Serial.println("Code 0 finished playing number: " + String(ansbuf[6], DEC));
-          Playing     = false;
-          break;
-
-        case 0x02:
-          // There are some serialisation issues here...
-          // Appearantly the status response can come in earlier than expected.
-          //Serial.println("The sound may still be playing..." + String(ansbuf[6], DEC));
-          break;
-
-        case 0x39:
-          Serial.println(F("Error playing file"));
-          break;          
-    
-        case 0x40:
-          Serial.println(F("Error"));
-          Error       = false;
-          break;
-    
-        case 0x41:
-          // Serial.println(F("Ok"));
-          Ok          = true;          
-          break;
-    
-        case 0x42:
-          // Not using this; the thing seems to think it's always playing
-          Serial.println(F("Playing"));
-          break;
-    
-        case 0x48:
-          FileCount = String(ansbuf[6], DEC);
-          Serial.print(F("FileCount "));
-          Serial.println(FileCount);
-          break;
-    
-        case 0x4C:
-          PlayingNumber = String(ansbuf[6], DEC);
-          Serial.print(F("Playing the following song: "));
-          Serial.println(PlayingNumber);
-          break;
-    
-        case 0x4E:
-          FolderFileCount = String(ansbuf[6], DEC);
-          Serial.print(F("FolderFileCount "));
-          Serial.println(FolderFileCount);
-          break;
-    
-        case 0x4F:
-          FolderCount = String(ansbuf[6], DEC);
-          Serial.print(F("FolderCount "));
-          Serial.println(FolderCount);
-          break;
-          
-        default:
-          // Unknown repsonse 39 seems to lead to error playing
-          // Unknown response 1 / 2 / 40
-          Serial.print(F("MP3 - Unknown response "));
-          Serial.println(ansbuf[3]);
-          break;
-      }
+  // Constant work per byte; the rest of an answer is taken on the next call
+  // The line was seen quiet for too long after the last byte; what comes now belongs to the next answer
+  if ( rxState != RX_START && (uint16_t)( rxQuiet - rxLast ) > MP3RXTIMEOUT ) {
+    resync(0);
+  }
+
+  while ( Port.available() ) {
+    if ( receive(Port.read()) ) {
+      rxAnswers++;
+      answer(rxCommand, rxData);
     }
+  }
+  rxLast  = millis();
+  rxQuiet = rxLast;
+
+  if ( rxState != RX_START ) {
+    LedArbiter.expect(MP3BYTEWINDOW);  // The rest of the answer is on its way
+  }
+}
+
+void answer(uint8_t command, uint16_t data) {
+  switch (command) {
+    case 0x3A:
+      MemoryCard  = true;
+      Serial.println(F("Memory card inserted"));
+      break;
+
+    case 0x3B:
+      MemoryCard  = false;
+      Serial.println(F("Memory card removed"));
+      break;      
+    
+    case 0x3D:
+      //Serial.print(F("Finished playing number: ")); Serial.println(data);
+      finished();
+      break;
+
+    case 0x39:
+      Serial.println(F("Error playing file"));
+      break;          
+
+    case 0x40:
+      Serial.println(F("Error"));
+      Error       = false;
+      break;
+
+    case 0x41:
+      // Serial.println(F("Ok"));
+      Ok          = true;          
+      break;
+
+    case 0x42:
+      // Not using this; the thing seems to think it's always playing
+      Serial.println(F("Playing"));
+      break;
+
+    case 0x48:
+      FileCount = data;
+      Serial.print(F("FileCount "));
+      Serial.println(FileCount);
+      break;
+
+    case 0x4C:
+      PlayingNumber = data;
+      Serial.print(F("Playing the following song: "));
+      Serial.println(PlayingNumber);
+      break;
+
+    case 0x4E:
+      FolderFileCount = data;
+      Serial.print(F("FolderFileCount "));
+      Serial.println(FolderFileCount);
+      break;
+
+    case 0x4F:
+      FolderCount = data;
+      Serial.print(F("FolderCount "));
+      Serial.println(FolderCount);
+      break;
+      
+    default:
+      // Unknown repsonse 39 seems to lead to error playing
+      Serial.print(F("MP3 - Unknown response "));
+      Serial.println(command);
+      break;
+  }
 }
 
 void clearSentence() {
@@ -287,12 +397,47 @@ void clearSentence() {
 }
 
 void playSample(uint8_t Number) {
-    Playing = true;
+    Playing       = true;
+    PlaySent      = false;
+    PlayStarted   = millis();
+    PlayingSample = Number;
     uint16_t PlayNumber = Number + ( FOLDER * 256 );
 
     sendCommand(CMD_PLAY_FOLDER_FILE, PlayNumber);
     //sendCommand(CMD_PLAY_W_INDEX, Number);
-    delay(100);
+}
+
+void finished() {
+  if ( not Playing || not PlaySent ) {
+    return;                        // The end of a word that was already followed up
+  }
+
+  unsigned long took = millis() - PlayStarted;
+
+  if ( took < MP3MINSAMPLE ) {
+    return;
+  }
+
+  if ( PlayingSample < MP3SAMPLES ) {
+    unsigned long steps = ( took + MP3SAMPLEUNIT - 1 ) / MP3SAMPLEUNIT;
+
+    if ( steps > 255 ) {
+      steps = 255;                 // Too long to predict; untilEnd() leaves it to the player
+    }
+    if ( steps > SampleTime[PlayingSample] ) {
+      SampleTime[PlayingSample] = steps;
+    }
+  }
+  Playing = false;
+}
+
+long untilEnd() {
+  uint8_t steps = ( PlayingSample < MP3SAMPLES ) ? SampleTime[PlayingSample] : 0;
+
+  if ( not PlaySent || steps == 0 || steps == 255 ) {
+    return MP3NOEND;
+  }
+  return (long)steps * MP3SAMPLEUNIT - (long)( millis() - PlayStarted );
 }
 
 void NextWord() {
@@ -302,30 +447,51 @@ void NextWord() {
       clearSentence();
     } else {
       // No; we can jump to the next word
-      // Serial.println("Done with this word; jumping to word " + String(Word)  + " Playing: " + String(Playing) + " Sleeping: " + String(Sleeping));
+      // Serial.print(F("Done with this word; jumping to word ")); Serial.println(Word);
     }
 }
 
 void update() {
-  if ( Mp3Serial.available() ) {
+  if ( Port.available() ) {
     mp3_status();                // Process status changes
+  } else if ( rxState != RX_START ) {
+    rxQuiet = millis();          // Nothing more of the answer yet
+  }
+
+  // A lost "finished" answer would keep the player busy forever
+  if ( Playing && millis() - PlayStarted > MP3PLAYTIMEOUT ) {
+    Serial.println(F("MP3 - No end of word; going on"));
+    playTimeouts++;
+    Playing = false;
+  }
+
+  long toEnd = Playing ? untilEnd() : MP3NOEND;
+
+  // The finished answer is due; keep the led pushes away from it
+  if ( toEnd <= MP3ENDWINDOW && toEnd > -MP3ENDWINDOW ) {
+    LedArbiter.expect(toEnd + MP3ENDWINDOW);
+  }
+
+  // More words to say and the one playing is about to end; send the next one now instead of after the answer
+  if ( Words > 0 && toEnd <= MP3PLAYLEAD ) {
+    playAhead++;
+    Playing = false;
   }
 
   if ( Words > 0 ) {           // There is an array set meaning we have some work to do
     //Serial.println(F("Words found; saying them..."));
-    //Serial.println("Sleeping: " + String(Sleeping) + " Playing: " + String(Playing));
+    //Serial.print(F("Sleeping: ")); Serial.print(Sleeping); Serial.print(F(" Playing: ")); Serial.println(Playing);
 
     if ( Sleeping ) {
         wake();                      // Wake the MP3 player if it is sleeping
         Playing = false;             // Implicit but might have issues
-        mp3_status();                // Process status changes
     }
   
     if ( Playing == false ) {
         // Player will enter Playing == false status through mp3_status() function
         if ( Words >= Word ) { // Not playing but there are still some words left...
           if ( Sentence[Word] != NULL ) {
-            //Serial.println("Playing word " + String(Word));
+            //Serial.print(F("Playing word ")); Serial.println(Word);
             playSample(Sentence[Word]);
             NextWord();
           }
@@ -333,197 +499,192 @@ void update() {
      }
   }
 
-  // Go to sleep when there is nothing to play and 
-  if ( Sleeping == false && Playing == false ) {
+  // Go to sleep when there has been nothing to play for a while
+  if ( Playing ) {
+    stayAwake(MP3IDLETIMEOUT);
+  } else if ( Sleeping == false && Words == 0 && (long)( millis() - AwakeUntil ) >= 0 ) {
     sleep();
   }
-  
+
+  transmit();
 }
 
 // Library translates time to the call of an MP3
 void Time(uint8_t hour, uint8_t minute) {
+  Serial.print(F("Saying "));
+  Serial.print(hour);
+  Serial.print(':');
+  Serial.println(minute);
+
+  Words               = Phrase(hour, minute, Sentence);
+  Sentence[Words]     = 0;      // Words is at most 5; Sentence has room for more
+  Word                = 0;
+}
 
-uint8_t afterhour   = hour;
-uint8_t beforehour  = hour;
-uint8_t CurrentWord = 0;
-
-  Sentence[CurrentWord] = HET_IS_NU;
-  CurrentWord ++;
-  
-  // Make sure 0 is said as 12
-  if ( hour == 0 ) {
-    afterhour = 12;
-  } else {
-    afterhour = hour;
-  }
-  
-  // Make sure the before hour is one bigger
-  if ( (hour % 12 ) == 0 ) {
-    beforehour = 1;
-  }  else {
-    beforehour = hour + 1;    
-  }  
-  
-  // Structure for saying the appropriate time
-  if ( minute % 15 == 0 ) {
-    // Handle quarterly
-    switch ( int ( minute / 15 ) ) {
-      case 0:
-        Serial.print(afterhour);
-        Serial.println(F(" uur"));
-        
-         Sentence[CurrentWord] = afterhour;
-         CurrentWord ++;
-         Sentence[CurrentWord] = UUR;
-         CurrentWord ++;
-        break;
-      case 1:
-        Serial.print(F("kwart over "));
-        Serial.println(afterhour);
-        
-         Sentence[CurrentWord] = KWART;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = OVER;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = afterhour;
-         CurrentWord ++;
-        break;
-      case 2:
-        Serial.print(F("half "));
-        Serial.println(beforehour);   
-        
-         Sentence[CurrentWord] = HALF;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = beforehour;
-         CurrentWord ++;           
-        break;
-      case 3:
-        Serial.print(F("kwart voor "));
-        Serial.println(beforehour);   
-        
-         Sentence[CurrentWord] = KWART;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = VOOR;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = beforehour;
-         CurrentWord ++;             
-        break;
-    }
-    
-  } else {
-    switch ( int ( minute / 15 ) ) {
-      case 0: // First quarter
-        Serial.print(minute);
-        Serial.print(F(" over "));
-        Serial.println(afterhour);   
-        
-         Sentence[CurrentWord] = minute;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = OVER;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = afterhour;
-         CurrentWord ++;           
-      break;
-      case 1: // Second quarter
-        Serial.print(30 - minute);
-        Serial.print(F(" voor half "));
-        Serial.println(beforehour);  
-          
-         Sentence[CurrentWord] = 30 - minute;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = VOOR;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = HALF;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = beforehour;
-         CurrentWord ++;                    
-      break;
-      case 2: // Third quarter
-        Serial.print(minute - 30);
-        Serial.print(F(" over half "));
-        Serial.println(beforehour);     
-        
-         Sentence[CurrentWord] = minute - 30;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = OVER;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = HALF;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = beforehour;
-         CurrentWord ++;         
-      break;
-      case 3: // Fourth quarter
-        Serial.print(60 - minute);
-        Serial.print(F(" voor "));
-        Serial.println(beforehour);  
-        
-         Sentence[CurrentWord] = 60 - minute;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = VOOR;
-         CurrentWord ++;        
-         Sentence[CurrentWord] = beforehour;
-         CurrentWord ++;         
-      break;
-    }
-    
+// Fill words with the sentence for hour:minute on the dial; returns the amount of words
+uint8_t Phrase(uint8_t hour, uint8_t minute, uint8_t *words) {
+  const uint8_t *entry  = phrases[( hour % 12 ) * 60 + minute];
+  uint32_t       packed = pgm_read_byte(entry)
+                        | (uint32_t)pgm_read_byte(entry + 1) << 8
+                        | (uint32_t)pgm_read_byte(entry + 2) << 16;
+  uint8_t        count  = 0;
+
+  words[count++] = HET_IS_NU;
+  while ( packed ) {
+    words[count++] = packed & PHRASEWORDMASK;
+    packed >>= PHRASEWORDBITS;
   }
-
-  Words         = WordCount();  // Set the wordcount
-  Word          = 0;
+  return count;
 }
 
 /********************************************************************************/
-/*Function: Send command to the MP3                                         */
+/*Function: Queue a command for the MP3                                         */
 /*Parameter:-int8_t command                                                     */
 /*Parameter:-int16_ dat  parameter for the command                              */
 void sendCommand(int8_t command, int16_t dat)
 {
-  delay(20);
-  Send_buf[0] = 0x7e;   //
-  Send_buf[1] = 0xff;   //
-  Send_buf[2] = 0x06;   // Len
-  Send_buf[3] = command;//
-  Send_buf[4] = 0x01;   // 0x00 NO, 0x01 feedback
-  Send_buf[5] = (int8_t)(dat >> 8);  //datah
-  Send_buf[6] = (int8_t)(dat);       //datal
-  Send_buf[7] = 0xef;   //
-  //Serial.print("Sending: ");
-  for (uint8_t i = 0; i < 8; i++)
-  {
-    Mp3Serial.write(Send_buf[i]) ;
-    //Serial.print(sbyte2hex(Send_buf[i]));
+  uint8_t next = ( txTail + 1 ) & ( MP3QUEUESIZE - 1 );
+
+  if ( next == txHead ) {
+    Serial.println(F("MP3 queue is full; command dropped"));
+    txDropped++;
+    return;
   }
-  //Serial.println();
+  txQueue[txTail].command = command;
+  txQueue[txTail].data    = dat;
+  txTail = next;
 }
 
 /********************************************************************************/
-/*Function: sanswer. Returns a String answer from mp3 UART module.          */
-/*Parameter:- uint8_t b. void.                                                  */
-/*Return: String. If the answer is well formated answer.                        */
-String sanswer(void)
-{  
-  uint8_t i = 0;
-  String mp3answer = "";
-
-  // Get only 10 Bytes
-  while (Mp3Serial.available() && (i < 10))
-  {
-    uint8_t b = Mp3Serial.read();
-    ansbuf[i] = b;
-    i++;
-
-    mp3answer += sbyte2hex(b);
+/*Function: Send the next bytes of the queued commands                          */
+/*A buffered transport gets a whole frame at once, and only when all of it fits;*/
+/*nothing else written to the port can end up inside a frame. Through           */
+/*SoftwareSerial it's one byte per call: a byte takes ~1 ms at 9600 baud with   */
+/*the interrupts off, so the loop keeps going while a frame is sent             */
+void transmit()
+{
+  if ( txHead == txTail ) {
+    return;
+  }
+
+  if ( txByte == 0 ) {
+    if ( (long)( millis() - txReady ) < 0 ) {
+      return;                          // Still busy with the previous command
+    }
+    if ( Transport::buffered && Port.room() < sizeof(Send_buf) ) {
+      return;                          // Not a part of a frame; the rest would come after whatever is written next
+    }
+    Send_buf[0] = 0x7e;   //
+    Send_buf[1] = 0xff;   //
+    Send_buf[2] = 0x06;   // Len
+    Send_buf[3] = txQueue[txHead].command;
+    Send_buf[4] = 0x01;   // 0x00 NO, 0x01 feedback
+    Send_buf[5] = (int8_t)(txQueue[txHead].data >> 8);  //datah
+    Send_buf[6] = (int8_t)(txQueue[txHead].data);       //datal
+    Send_buf[7] = 0xef;   //
+  }
+
+  do {
+    Port.write(Send_buf[txByte++]);
+    //printHex((uint8_t)Send_buf[txByte - 1], 2);
+  } while ( Transport::buffered && txByte < sizeof(Send_buf) );
+
+  if ( txByte == sizeof(Send_buf) ) {
+    if ( txQueue[txHead].command == CMD_PLAY_FOLDER_FILE ) {
+      PlayStarted = millis();          // The player starts about now; the duration index counts from here
+      PlaySent    = true;
+    }
+    txByte  = 0;
+    txReady = millis() + commandGap(txQueue[txHead].command);
+    LedArbiter.expect(MP3ACKWINDOW);
+    txHead  = ( txHead + 1 ) & ( MP3QUEUESIZE - 1 );
   }
+}
+
+uint16_t commandGap(uint8_t command)
+{
+  switch ( command ) {
+    case CMD_SEL_DEV:
+    case CMD_RESET:
+      return MP3MOUNTGAP;
+    case CMD_WAKE_UP:
+      return MP3WAKEGAP;
+  }
+  return MP3COMMANDGAP;
+}
+
+/********************************************************************************/
+/*Function: Take the next byte of an answer from the MP3 player                 */
+/*Parameter:- uint8_t b. The byte received                                      */
+/*Return: bool. True when b completes a valid answer (rxCommand, rxData)        */
+bool receive(uint8_t b)
+{
+  uint8_t state = rxState++;
+
+  switch ( state ) {
+    case RX_START:
+      rxState = ( b == MP3_START ) ? RX_VERSION : RX_START;
+      rxSum   = 0;
+      return false;
+
+    case RX_VERSION:
+      if ( b != MP3_VERSION ) { return resync(b); }
+      break;
+
+    case RX_LENGTH:
+      if ( b != MP3_LENGTH )  { return resync(b); }
+      break;
+
+    case RX_COMMAND:
+      if ( b == MP3_START )   { return resync(b); }   // No answer has that command; the next answer starts
+      rxCommand = b;
+      break;
+
+    case RX_FEEDBACK:
+      if ( b == MP3_START )   { return resync(b); }
+      break;
+
+    case RX_DATAH:
+      rxData  = (uint16_t)b << 8;
+      break;
 
-  // if the answer format is correct.
-  if ((ansbuf[0] == 0x7E) && (ansbuf[9] == 0xEF))
-  {
-    return mp3answer;
+    case RX_DATAL:
+      rxData |= b;
+      break;
+
+    case RX_CHECKH:
+      if ( b == MP3_END ) {            // Sent without a checksum
+        rxState = RX_START;
+        return true;
+      }
+      if ( b == MP3_START )   { return resync(b); }   // The checksum of six bytes starts with 0xFA .. 0xFE
+      rxCheck = (uint16_t)b << 8;
+      return false;
+
+    case RX_CHECKL:
+      rxCheck |= b;
+      if ( (uint16_t)( rxCheck + rxSum ) != 0 ) { return resync(b); }
+      return false;
+
+    case RX_END:
+      if ( b != MP3_END )     { return resync(b); }
+      rxState = RX_START;
+      return true;
   }
 
-  return "???: " + mp3answer;
+  rxSum += b;
+  return false;
 }
 
+/*Drop the answer being received; the byte that didn't fit may start the next   */
+/*one (0x7E)                                                                    */
+bool resync(uint8_t b)
+{
+  rxErrors++;
+  rxState = ( b == MP3_START ) ? RX_VERSION : RX_START;
+  rxSum   = 0;
+  return false;
+}
 
 void printHex(int num, int precision) {
      char tmp[16];
@@ -537,24 +698,16 @@ void printHex(int num, int precision) {
 
 
 
-/********************************************************************************/
-/*Function: sbyte2hex. Returns a byte data in HEX format.                 */
-/*Parameter:- uint8_t b. Byte to convert to HEX.                                */
-/*Return: String                                                                */
-String sbyte2hex(uint8_t b)
-{
-  String shex;
-
-  shex = "0X";
-
-  if (b < 16) shex += "0";
-  shex += String(b, HEX);
-  shex += " ";
-  return shex;
-}
+};
 
+#if MP3TRANSPORT == MP3_HARDWARESERIAL
+typedef Speech<Mp3HardwareSerial> ClockSpeech;
+#else
+typedef Speech<Mp3SoftwareSerial> ClockSpeech;
+#endif
 
-};
+// What the speech layer keeps besides the transport; checked when compiling instead of finding out on a crash
+static_assert(sizeof(ClockSpeech) - sizeof(ClockSpeech::Port) <= MP3SRAMBUDGET, "The speech layer takes more SRAM than MP3SRAMBUDGET");
 
-Speech Mp3Speech;
+ClockSpeech Mp3Speech;
 
@@ -0,0 +1,115 @@
+/*
+ * Transport Library
+ *
+ * The serial connections to the MP3 player; Speech (speech.h) is a template on one of these:
+ *  - Mp3SoftwareSerial   -- Bit-banged on MP3_RX / MP3_TX. The interrupts are off for ~1 ms per byte sent and
+ *                           bytes received during a led push get lost, so Speech sends one byte per update().
+ *  - Mp3HardwareSerial   -- The hardware UART (D0 / D1). Interrupt driven and buffered; a command frame is put
+ *                           in the transmit buffer at once, and only when all of it fits, so no debug output ends
+ *                           up inside a frame. The USB serial port shares the UART: the debug output goes to the
+ *                           MP3 player as well (it skips everything up to the 0x7E of a frame) and setting the
+ *                           time through the serial port is off.
+ *  - Mp3Loopback         -- In memory, for host tests: what Speech sends is kept, answers are put in with inject()
+ *                           and limit() makes it short of room the way a busy UART is.
+ *
+ * A transport is buffered when it takes a whole frame without the loop waiting for it; Speech writes a frame to a
+ * buffered transport in one go, to the others a byte at a time.
+ *
+ * MP3TRANSPORT selects the one the clock uses.
+ *
+ *  Functions (all transports):
+ *    begin()           -- Start the connection at a baud rate
+ *    available()       -- Amount of bytes received
+ *    read()            -- The next byte received
+ *    room()            -- Amount of bytes that can be written now without waiting
+ *    write()           -- Send a byte
+ *    buffered          -- Whether a whole frame is written at once
+ *
+ */
+
+#define MP3_SOFTWARESERIAL        0
+#define MP3_HARDWARESERIAL        1
+
+#define MP3TRANSPORT  MP3_SOFTWARESERIAL  // The way the MP3 player is connected
+
+#define MP3LOOPBACKSIZE          32  // Bytes kept per direction by Mp3Loopback; a power of two
+
+class Mp3SoftwareSerial {
+private:
+  SoftwareSerial  port;
+
+public:
+  static const bool buffered = false;
+
+  Mp3SoftwareSerial() : port(MP3_RX, MP3_TX) {}
+
+  void    begin(long baud)        { port.begin(baud); }
+  int     available()             { return port.available(); }
+  int     read()                  { return port.read(); }
+  uint8_t room()                  { return 1; }     // A byte at a time; each one keeps the interrupts off
+  void    write(uint8_t b)        { port.write(b); }
+};
+
+class Mp3HardwareSerial {
+public:
+  static const bool buffered = true;
+
+  void    begin(long baud)        { Serial.begin(baud); }
+  int     available()             { return Serial.available(); }
+  int     read()                  { return Serial.read(); }
+  uint8_t room()                  { return Serial.availableForWrite(); }
+  void    write(uint8_t b)        { Serial.write(b); }
+};
+
+class Mp3Loopback {
+private:
+  uint8_t rx[MP3LOOPBACKSIZE];
+  uint8_t tx[MP3LOOPBACKSIZE];
+  uint8_t rxHead  = 0;
+  uint8_t rxTail  = 0;
+  uint8_t txHead  = 0;
+  uint8_t txTail  = 0;
+  uint8_t txLimit = MP3LOOPBACKSIZE;  // Room at most, as if a UART buffer were partly full
+
+public:
+  static const bool buffered = true;
+
+  void    begin(long)             { }
+  int     available()             { return ( rxTail - rxHead ) & ( MP3LOOPBACKSIZE - 1 ); }
+
+  uint8_t room() {
+    uint8_t free = ( txHead - txTail - 1 ) & ( MP3LOOPBACKSIZE - 1 );
+    return ( free < txLimit ) ? free : txLimit;
+  }
+
+  int read() {
+    if ( rxHead == rxTail ) {
+      return -1;
+    }
+    uint8_t b = rx[rxHead];
+    rxHead = ( rxHead + 1 ) & ( MP3LOOPBACKSIZE - 1 );
+    return b;
+  }
+
+  void write(uint8_t b) {
+    tx[txTail] = b;
+    txTail = ( txTail + 1 ) & ( MP3LOOPBACKSIZE - 1 );
+  }
+
+  // The test side: an answer of the MP3 player, the bytes Speech sent and the room it gets
+  void inject(uint8_t b) {
+    rx[rxTail] = b;
+    rxTail = ( rxTail + 1 ) & ( MP3LOOPBACKSIZE - 1 );
+  }
+
+  int sent() {
+    if ( txHead == txTail ) {
+      return -1;
+    }
+    uint8_t b = tx[txHead];
+    txHead = ( txHead + 1 ) & ( MP3LOOPBACKSIZE - 1 );
+    return b;
+  }
+
+  void limit(uint8_t bytes)       { txLimit = bytes; }
+};
@@ -0,0 +1,58 @@
+/*
+ * Time zone rules  (Used by the rtc.h library)
+ *
+ * The DST switches of a time zone in the spirit of a POSIX TZ string ("CET-1CEST,M3.5.0,M10.5.0/3"):
+ * the shift in minutes and for both switches the month, week (5 = last), day of the week (0 = sunday) and hour.
+ * The start hour is in standard (winter) time and the end hour in summer time, just like POSIX.
+ * A zone that switches to summer time late in the year (southern hemisphere) simply has start after end.
+ *
+ * The zones live in a small table in flash. TIMEZONE picks one at build time; a valid zone number in the
+ * EEPROM (EEPROM_TZ) overrides it so the same build can be deployed in another region.
+ *
+ *  Zones:
+ *    TZ_NONE           -- No DST at all
+ *    TZ_EUROPE         -- Central Europe       CET-1CEST,M3.5.0,M10.5.0/3
+ *    TZ_UK             -- UK / Portugal        GMT0BST,M3.5.0/1,M10.5.0
+ *    TZ_EASTEUROPE     -- Eastern Europe       EET-2EEST,M3.5.0/3,M10.5.0/4
+ *    TZ_US             -- US / Canada          EST5EDT,M3.2.0,M11.1.0
+ *    TZ_AUSTRALIA      -- South east Australia AEST-10AEDT,M10.1.0,M4.1.0/3
+ *    TZ_NEWZEALAND     -- New Zealand          NZST-12NZDT,M9.5.0,M4.1.0/3
+ *
+ */
+
+#define TZ_NONE                   0
+#define TZ_EUROPE                 1
+#define TZ_UK                     2
+#define TZ_EASTEUROPE             3
+#define TZ_US                     4
+#define TZ_AUSTRALIA              5
+#define TZ_NEWZEALAND             6
+#define TZ_ZONES                  7
+
+#define TIMEZONE          TZ_EUROPE  // The zone used when the EEPROM doesn't hold one
+
+#define TZ_LAST                   5  // Week 5 is the last week of the month
+
+// One switch; "M3.5.0/2" is { 3, TZ_LAST, 0, 2 }
+struct TZRule {
+  uint8_t month;                     // 1..12; 0 = no DST
+  uint8_t week;                      // 1..4 or TZ_LAST
+  uint8_t day;                       // Day of the week; 0 = sunday
+  uint8_t hour;                      // Local time of the switch
+};
+
+struct TimeZone {
+  uint8_t shift;                     // Minutes the clock moves forward in summer
+  TZRule  start;                     // Standard time -> summer time; hour in standard time
+  TZRule  end;                       // Summer time -> standard time; hour in summer time
+};
+
+const TimeZone timeZones[TZ_ZONES] PROGMEM = {
+  { 60, {  0, 0,       0, 0 }, {  0, 0,       0, 0 } },   // TZ_NONE; the shift undoes a stored summer time
+  { 60, {  3, TZ_LAST, 0, 2 }, { 10, TZ_LAST, 0, 3 } },   // TZ_EUROPE
+  { 60, {  3, TZ_LAST, 0, 1 }, { 10, TZ_LAST, 0, 2 } },   // TZ_UK
+  { 60, {  3, TZ_LAST, 0, 3 }, { 10, TZ_LAST, 0, 4 } },   // TZ_EASTEUROPE
+  { 60, {  3, 2,       0, 2 }, { 11, 1,       0, 2 } },   // TZ_US
+  { 60, { 10, 1,       0, 2 }, {  4, 1,       0, 3 } },   // TZ_AUSTRALIA
+  { 60, {  9, TZ_LAST, 0, 2 }, {  4, 1,       0, 3 } }    // TZ_NEWZEALAND
+};